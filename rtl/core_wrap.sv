@@ -5,7 +5,12 @@
 // Authors:
 // - Philippe Sauter <phsauter@iis.ee.ethz.ch>
 
-module core_wrap import croc_pkg::*; #() (
+module core_wrap import croc_pkg::*; #(
+  // Zknh and Zbkb: the Zbkb rotates, andn/orn/xnor, pack and rev8 come with the
+  // balanced bit-manipulation subset, the SHA-256 instructions, brev8 and zip/unzip
+  // with RV32Zk
+  parameter bit ScalarCrypto = 1'b0
+) (
   input  logic clk_i,
   input  logic rst_ni,
   input  logic ref_clk_i,
@@ -60,7 +65,8 @@ module core_wrap import croc_pkg::*; #() (
     .MHPMCounterWidth   ( 40                  ),
     .RV32E              ( 0                   ),
     .RV32M              ( cve2_pkg::RV32MNone ),
-    .RV32B              ( cve2_pkg::RV32BNone ),
+    .RV32B              ( ScalarCrypto ? cve2_pkg::RV32BBalanced : cve2_pkg::RV32BNone ),
+    .RV32Zk             ( ScalarCrypto        ),
     .DbgTriggerEn       ( 1'b1                ),
     .DbgHwBreakNum      ( 1                   ),
     .DmHaltAddr         ( DebugAddrOffset + dm::HaltAddress[31:0]      ),
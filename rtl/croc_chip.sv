@@ -160,6 +160,7 @@ module croc_chip import croc_pkg::*; #() (
     .clk_i          ( soc_clk_i      ),
     .rst_ni         ( soc_rst_ni     ),
     .ref_clk_i      ( soc_ref_clk_i  ),
+    .acc_clk_i      ( soc_clk_i      ), // no separate accelerator clock pad
     .testmode_i     ( soc_testmode_i ),
     .fetch_en_i     ( soc_fetch_en_i ),
     .status_o       ( soc_status_o   ),
@@ -47,6 +47,7 @@ module croc_domain import croc_pkg::*; #(
   // Control Signals
   // -----------------
   logic sram_impl; // soc_ctrl -> SRAM config signals
+  logic [NumXbarManagers-1:0][XbarPrioWidth-1:0] xbar_prio; // soc_ctrl -> xbar manager priorities
   logic debug_req;
   logic fetch_enable;
   logic [31:0] boot_addr;
@@ -176,6 +177,7 @@ module croc_domain import croc_pkg::*; #(
   // Core
   // -----------------
   core_wrap #(
+    .ScalarCrypto ( CoreScalarCrypto )
   ) i_core_wrap (
     .clk_i,
     .rst_ni,
@@ -304,6 +306,23 @@ module croc_domain import croc_pkg::*; #(
   // Main Interconnect
   // -----------------
 
+  // Manager requests towards the xbar, SRAM addresses permuted when the banks are interleaved
+  mgr_obi_req_t [NumXbarManagers-1:0] xbar_mgr_obi_req;
+
+  always_comb begin
+    xbar_mgr_obi_req = {core_instr_obi_req, core_data_obi_req, dbg_req_obi_req, user_mgr_obi_req_i};
+    for (int i = 0; i < NumXbarManagers; i++) begin
+      xbar_mgr_obi_req[i].a.addr = sram_bank_addr(xbar_mgr_obi_req[i].a.addr);
+    end
+  end
+
+  // the permutation in sram_bank_addr moves whole address bits, so the bank count and
+  // the bank size must both be powers of two or addresses alias
+  if (SramInterleave && ((NumSramBanks & (NumSramBanks - 1)) != 0 ||
+      (SramBankNumWords & (SramBankNumWords - 1)) != 0)) begin : gen_interleave_err
+    $fatal(1, "croc_domain: SramInterleave needs a power-of-two NumSramBanks and SramBankNumWords");
+  end
+
   obi_xbar #(
     .SbrPortObiCfg      ( MgrObiCfg        ),
     .MgrPortObiCfg      ( SbrObiCfg        ),
@@ -319,20 +338,22 @@ module croc_domain import croc_pkg::*; #(
     .NumAddrRules       ( NumXbarSbrRules  ),
     .addr_map_rule_t    ( addr_map_rule_t  ),
     .UseIdForRouting    ( 1'b0             ),
-    .Connectivity       ( '1               )
+    .Connectivity       ( '1               ),
+    .PrioWidth          ( XbarPrioWidth    )
   ) i_main_xbar (
     .clk_i,
     .rst_ni,
     .testmode_i,
 
-    .sbr_ports_req_i  ( {core_instr_obi_req, core_data_obi_req, dbg_req_obi_req, user_mgr_obi_req_i } ), // from managers towards subordinates
+    .sbr_ports_req_i  ( xbar_mgr_obi_req ), // from managers towards subordinates
     .sbr_ports_rsp_o  ( {core_instr_obi_rsp, core_data_obi_rsp, dbg_req_obi_rsp, user_mgr_obi_rsp_o } ),
     .mgr_ports_req_o  ( all_sbr_obi_req ), // connections to subordinates
     .mgr_ports_rsp_i  ( all_sbr_obi_rsp ),
 
     .addr_map_i       ( croc_addr_map   ),
     .en_default_idx_i ( 4'b1111          ),
-    .default_idx_i    ( '0              )
+    .default_idx_i    ( '0              ),
+    .sbr_ports_prio_i ( xbar_prio        )
   );
 
   // -----------------
@@ -504,12 +525,14 @@ module croc_domain import croc_pkg::*; #(
   assign fetch_enable    = soc_ctrl_reg2hw.fetchen.q | fetch_en_i;
   assign boot_addr       = soc_ctrl_reg2hw.bootaddr.q;
   assign sram_impl       = soc_ctrl_reg2hw.sram_dly;
+  assign xbar_prio       = soc_ctrl_reg2hw.xbar_prio.q;
   assign soc_ctrl_hw2reg = '0;
 
   soc_ctrl_reg_top #(
-    .reg_req_t       ( reg_req_t    ),
-    .reg_rsp_t       ( reg_rsp_t    ),
-    .BootAddrDefault ( SramBaseAddr )
+    .reg_req_t       ( reg_req_t       ),
+    .reg_rsp_t       ( reg_rsp_t       ),
+    .BootAddrDefault ( SramBaseAddr    ),
+    .XbarPrioDefault ( XbarPrioDefault )
   ) i_soc_ctrl (
     .clk_i,
     .rst_ni,
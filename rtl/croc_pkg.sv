@@ -38,6 +38,13 @@ package croc_pkg;
   // Number of additional interrupts coming into croc_domain and going to the core
   localparam int unsigned NumExternalIrqs = 4;
 
+  // Scalar crypto in the core: SHA-256 sigma instructions (Zknh) and rotates/packs (Zbkb),
+  // for software built with RISCV_MARCH=rv32i_zicsr_zknh_zbkb
+`ifndef CORE_SCALAR_CRYPTO
+`define CORE_SCALAR_CRYPTO 0
+`endif
+  localparam bit CoreScalarCrypto = `CORE_SCALAR_CRYPTO;
+
 
   ///////////////////////
   // Address Maps     ///
@@ -65,12 +72,31 @@ package croc_pkg;
   localparam int unsigned SramBankAddrWidth = cf_math_pkg::idx_width(SramBankNumWords);
   localparam int unsigned SramAddrRange     = NumSramBanks*SramBankNumWords*4;
 
+  // Interleave the SRAM banks word by word instead of one contiguous region per bank, so
+  // managers streaming through memory spread over all banks (NumSramBanks and
+  // SramBankNumWords powers of two)
+`ifndef SRAM_INTERLEAVE
+`define SRAM_INTERLEAVE 0
+`endif
+  localparam bit          SramInterleave    = `SRAM_INTERLEAVE;
+  localparam int unsigned SramBankSelWidth  = cf_math_pkg::idx_width(NumSramBanks);
+  localparam int unsigned SramRangeWidth    = cf_math_pkg::idx_width(SramAddrRange);
+
   localparam bit [31:0]   UserBaseAddr      = 32'h2000_0000;
   localparam bit [31:0]   UserAddrRange     = 32'h6000_0000;
 
   localparam int unsigned NumCrocDomainSubordinates = 2 + NumSramBanks; // Peripherals + Memory + User Domain
   
   localparam int unsigned NumXbarManagers = 4; // Debug module, Core Instr, Core Data, User Domain
+
+  // Arbitration priority of the xbar managers, XbarPrioWidth bits each from bit 0: User Domain,
+  // Debug module, Core Data, Core Instr. The highest requesting priority wins, round-robin
+  // among equals; reset value of soc_ctrl.xbar_prio (all equal: plain round-robin).
+`ifndef XBAR_PRIO
+`define XBAR_PRIO 8'h00
+`endif
+  localparam int unsigned XbarPrioWidth   = 2;
+  localparam logic [NumXbarManagers*XbarPrioWidth-1:0] XbarPrioDefault = `XBAR_PRIO;
   localparam int unsigned NumXbarSbrRules = NumCrocDomainSubordinates; // number of address rules in the decoder
   localparam int unsigned NumXbarSbr      = NumXbarSbrRules + 1; // additional OBI error, used for signal arrays
 
@@ -103,6 +129,20 @@ package croc_pkg;
 
   localparam addr_map_rule_t [NumXbarSbrRules-1:0] croc_addr_map = gen_xbar_addr_rules();
 
+  // With SramInterleave the SRAM address bits are permuted ahead of the xbar: the bank
+  // select bits of the contiguous rules above take the lowest word address bits, and
+  // the word address within the bank the bits above them
+  function automatic logic [31:0] sram_bank_addr(logic [31:0] addr);
+    logic [31:0] ret;
+    ret = addr;
+    if (SramInterleave && NumSramBanks > 1 &&
+        addr >= SramBaseAddr && addr < SramBaseAddr + SramAddrRange) begin
+      ret[SramRangeWidth-1 -: SramBankSelWidth]  = addr[2 +: SramBankSelWidth];
+      ret[SramRangeWidth-SramBankSelWidth-1 : 2] = addr[SramRangeWidth-1 : 2+SramBankSelWidth];
+    end
+    return ret;
+  endfunction
+
 
   /////////////////////////////
   // Peripheral address map ///
@@ -11,6 +11,7 @@ module croc_soc import croc_pkg::*; #(
   input  logic clk_i,
   input  logic rst_ni,
   input  logic ref_clk_i,
+  input  logic acc_clk_i, // SHA-256 accelerator clock, only used with user_pkg::ShaAsyncClk
   input  logic testmode_i,
   input  logic fetch_en_i,
   output logic status_o,
@@ -100,6 +101,7 @@ user_domain #(
   .clk_i,
   .rst_ni ( synced_rst_n ),
   .ref_clk_i,
+  .acc_clk_i,
   .testmode_i,
 
   .user_sbr_obi_req_i ( user_sbr_obi_req ),
@@ -0,0 +1,95 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+// Author: Nikola Tesic, ETH Zurich
+
+// OBI clock domain crossing: the A channel goes from src to dst and the R channel back
+// through one cdc_fifo_gray each. OBI has no backpressure on R, so the src side grants at
+// most 2**LogDepth outstanding transactions, which the R FIFO can always hold.
+module ethz_obi_cdc #(
+    parameter type         obi_req_t    = logic,
+    parameter type         obi_rsp_t    = logic,
+    parameter type         obi_a_chan_t = logic,
+    parameter type         obi_r_chan_t = logic,
+    parameter int unsigned LogDepth     = 2, // FIFO depth and outstanding transactions: 2**LogDepth
+    parameter int unsigned SyncStages   = 2
+)(
+    // manager side
+    input  logic     src_clk_i,
+    input  logic     src_rst_ni,
+    input  obi_req_t src_req_i,
+    output obi_rsp_t src_rsp_o,
+
+    // subordinate side
+    input  logic     dst_clk_i,
+    input  logic     dst_rst_ni,
+    output obi_req_t dst_req_o,
+    input  obi_rsp_t dst_rsp_i
+);
+
+    localparam int unsigned MaxTrans = 2**LogDepth;
+
+    logic [LogDepth:0] outstanding_q, outstanding_d;
+    logic a_ready, a_valid, r_valid, r_ready;
+
+    // src: grant while the A FIFO has room and the R FIFO has room for the response
+    assign a_valid = src_req_i.req && (outstanding_q != MaxTrans);
+    assign src_rsp_o.gnt    = a_valid && a_ready;
+    assign src_rsp_o.rvalid = r_valid;
+
+    always_comb begin
+        outstanding_d = outstanding_q;
+        if (src_rsp_o.gnt) outstanding_d = outstanding_d + 1;
+        if (r_valid)       outstanding_d = outstanding_d - 1;
+    end
+
+    always_ff @(posedge src_clk_i or negedge src_rst_ni) begin
+        if (!src_rst_ni) begin
+            outstanding_q <= '0;
+        end else begin
+            outstanding_q <= outstanding_d;
+        end
+    end
+
+    cdc_fifo_gray #(
+        .T           ( obi_a_chan_t ),
+        .LOG_DEPTH   ( LogDepth     ),
+        .SYNC_STAGES ( SyncStages   )
+    ) i_cdc_a (
+        .src_rst_ni  ( src_rst_ni      ),
+        .src_clk_i   ( src_clk_i       ),
+        .src_data_i  ( src_req_i.a     ),
+        .src_valid_i ( a_valid         ),
+        .src_ready_o ( a_ready         ),
+
+        .dst_rst_ni  ( dst_rst_ni      ),
+        .dst_clk_i   ( dst_clk_i       ),
+        .dst_data_o  ( dst_req_o.a     ),
+        .dst_valid_o ( dst_req_o.req   ),
+        .dst_ready_i ( dst_rsp_i.gnt   )
+    );
+
+    // dst: the outstanding limit on the src side leaves room for every response
+    cdc_fifo_gray #(
+        .T           ( obi_r_chan_t ),
+        .LOG_DEPTH   ( LogDepth     ),
+        .SYNC_STAGES ( SyncStages   )
+    ) i_cdc_r (
+        .src_rst_ni  ( dst_rst_ni       ),
+        .src_clk_i   ( dst_clk_i        ),
+        .src_data_i  ( dst_rsp_i.r      ),
+        .src_valid_i ( dst_rsp_i.rvalid ),
+        .src_ready_o ( r_ready          ),
+
+        .dst_rst_ni  ( src_rst_ni       ),
+        .dst_clk_i   ( src_clk_i        ),
+        .dst_data_o  ( src_rsp_o.r      ),
+        .dst_valid_o ( r_valid          ),
+        .dst_ready_i ( 1'b1             )
+    );
+
+    logic unused_r_ready;
+    assign unused_r_ready = r_ready;
+
+endmodule
@@ -5,7 +5,10 @@
 // Author: Nikola Tesic, ETH Zurich
 module ethz_sha2
 import shapkg::*;
-(
+#(
+    parameter int unsigned RoundsPerCycle = 1, // rounds unrolled per cycle: 1, 2 or 4
+    parameter int unsigned NumLanes = 1        // messages hashed side by side: 1 to 4
+)(
     input logic clk_i,          // Clock input
     input logic rst_ni,         // Reset input (active low)
     input sbr_obi_req_t user_sbr_obi_req_i, // Input message to hash or to save
@@ -25,61 +28,221 @@ import shapkg::*;
     logic we_o;
     logic req_o_q;
     logic req_o_d;
-    logic read_q;
-    logic read_d;
 
-    //for hash
-    logic [31:0] wkk_main_comb;
-    logic [31:0] kkk_main_comb;
+    //for hash: one block takes CyclesPerBlock cycles of RoundsPerCycle rounds
+    localparam int unsigned CyclesPerBlock = 64 / RoundsPerCycle;
 
-    logic [31:0] wkk15_comb , wkk2_comb, wkk16_comb, wkk7_comb, wkk_new_comb; 
-    logic [31:0] words_q [0:15];
-    logic [31:0] words_d [0:15];
+    //Every lane hashes its own message of LEN bytes in lockstep with lane 0:
+    //the lanes have their own state, schedule and buffers and share the FSM,
+    //the counters and the manager port (the fetch loads the lanes in turn)
 
-    logic [31:0] ato_h_q [0:7];
-    logic [31:0] ato_h_d [0:7];
-    logic [31:0] ato_h_main_comb [0:7];
-    logic [31:0] ato_h_new_comb [0:7]; 
-    logic [31:0] next_chunk_comb [0:15];
+    //h + K[t] + W[t] of each round, registered one cycle ahead of the rounds.
+    //h of round r of the next cycle is a register only while r + RoundsPerCycle
+    //<= 3; later rounds (all of them at 4 per cycle) register K + W and add h.
+    logic [31:0] hkw_q [0:NumLanes-1][0:RoundsPerCycle-1];
+    logic [31:0] hkw_d [0:NumLanes-1][0:RoundsPerCycle-1];
+    //operands of hkw of the next cycle, added in one carry-save tree: K (or a
+    //precomputed K + W), W and a second word term (the digest feed-forward)
+    logic [31:0] k_nxt_comb [0:NumLanes-1][0:RoundsPerCycle-1];
+    logic [31:0] w_nxt_comb [0:NumLanes-1][0:RoundsPerCycle-1];
+    logic [31:0] wx_nxt_comb [0:NumLanes-1][0:RoundsPerCycle-1];
+    logic        hkw_load_comb;
+    logic        hkw_ff_comb;  // h of the next cycle is ato_h_q + hout_q, added in the tree
+    logic        hkw_round_comb; // h of the next cycle comes from this cycle's rounds
+
+    //schedule window extended by the words expanded in this cycle
+    logic [31:0] wkk_ext_comb [0:NumLanes-1][0:15+RoundsPerCycle];
+    logic [31:0] words_q [0:NumLanes-1][0:15];
+    logic [31:0] words_d [0:NumLanes-1][0:15];
+
+    //prefetch buffer: block fblk is loaded here while words_q is hashed
+    logic [31:0] pref_q [0:NumLanes-1][0:15];
+    logic [31:0] pref_d [0:NumLanes-1][0:15];
+    logic        pref_full_q;
+    logic        pref_full_d;
+    logic        fetch_q;     // prefetch engine running
+    logic        fetch_d;
+
+    //lanes of the job, lane being fetched and its byte offset from IN_PTR
+    logic [2:0]  nlane_q;
+    logic [2:0]  nlane_d;
+    logic [2:0]  flane_q;
+    logic [2:0]  flane_d;
+    logic [31:0] fbase_q;
+    logic [31:0] fbase_d;
+
+    logic [31:0] ato_h_q [0:NumLanes-1][0:7];
+    logic [31:0] ato_h_d [0:NumLanes-1][0:7];
+    //working variables before and after each round of the cycle
+    logic [31:0] ato_h_chain_comb [0:NumLanes-1][0:RoundsPerCycle][0:7];
 
     //for output
-    logic [31:0] hout_q [0:7];
-    logic [31:0] hout_d [0:7];
+    logic [31:0] hout_q [0:NumLanes-1][0:7];
+    logic [31:0] hout_d [0:NumLanes-1][0:7];
     logic [31:0] hout_o;
     
     // State machine states
-    typedef enum logic [1:0] {
-        Idle    = 2'b00,
-        Hashing   = 2'b01,
-        Chank_load = 2'b10,
-        Output = 2'b11
+    typedef enum logic [2:0] {
+        Idle       = 3'b000,
+        Fetch      = 3'b001,
+        Hashing    = 3'b010,
+        Chank_load = 3'b011,
+        Output     = 3'b100,
+        Desc       = 3'b101
     } state;
     
     state state_q, state_d;
 
-    //counter for hash
-    logic [8:0] coun_h_q;
-    logic [8:0] coun_h_d;
+    //counter for hash (round within the block)
+    logic [5:0] coun_h_q;
+    logic [5:0] coun_h_d;
 
-    //counter for input and output
+    //counters for input and output (word within the block or digest):
+    //coun_req counts granted requests, coun_io the responses. The interconnect
+    //returns the responses of one manager in order, so no ID bookkeeping is needed.
+    logic [5:0] coun_req_q;
+    logic [5:0] coun_req_d;
     logic [5:0] coun_io_q;
     logic [5:0] coun_io_d;
 
+    //message length in bytes, number of blocks after padding and current block
+    logic [31:0] len_q;
+    logic [31:0] len_d;
+    logic [31:0] tlen_q;      // total length for the padding: PRE_LEN + LEN
+    logic [31:0] tlen_d;
+    logic        nopad_q;     // no padding, the last block is filled with zeros
+    logic        nopad_d;
+
+    //HMAC: a key job hashes K0 ^ ipad and then K0 ^ opad (kept in pref_q) into
+    //IH and OH; an HMAC job hashes the message from IH and then its digest from OH
+    logic        key_q;
+    logic        key_d;
+    logic        hmac_q;
+    logic        hmac_d;
+    logic        outer_q;     // second pass: K0 ^ opad, or the outer hash
+    logic        outer_d;
+
+    //iterations left: the digest is padded as a 32-byte message and hashed again
+    logic [31:0] iter_q;
+    logic [31:0] iter_d;
+
+    //nonce search: the template block stays in pref_q, every attempt hashes it
+    //with the nonce in word NONCE_IDX from H0..H7 (LOAD_H) or SHA_IV
+    logic        search_q;
+    logic        search_d;
+    logic        loadh_q;     // LOAD_H of the job, every attempt starts from H0..H7
+    logic        loadh_d;
+    logic        found_q;     // H0 of the digest was below TARGET
+    logic        found_d;
+
+    //bus errors: a response with err set marks the job; it ends, without
+    //writing the digest, once no read of it is in flight
+    logic        berr_q;
+    logic        berr_d;
+    logic [31:0] nonce_q;
+    logic [31:0] nonce_d;
+    logic [31:0] count_q;     // attempts left, including the running one
+    logic [31:0] count_d;
+    logic [31:0] nonce_save_comb;
+    logic        miss_comb;   // last block of an attempt and H0 not below TARGET
+    logic        save_nonce;
+    //ring mode: jobs are read from the descriptors at RING_BASE, HEAD to TAIL
+    logic        ring_q;
+    logic        ring_d;
+    logic [31:0] irqc_q;      // jobs finished since the last interrupt
+    logic [31:0] irqc_d;
+    logic        job_end_comb; // the job is finished
+    logic        ring_step;   // step HEAD and COUNT
+    logic        ring_irq;    // set DONE, the ring goes on
+    logic        ring_stop;   // HEAD reached TAIL, the ring ends
+    logic        desc_we;     // write a descriptor word into the job registers
+
+    //PIO: the message of up to 64 bytes is in MSG0..MSG15, loaded into pref_q
+    //in one cycle, and the digest is only left in H0..H7
+    logic        pio_q;
+    logic        pio_d;
+    logic [26:0] nblk_q;
+    logic [26:0] nblk_d;
+    logic [26:0] blk_q;       // block being hashed
+    logic [26:0] blk_d;
+    logic [26:0] fblk_q;      // block being prefetched
+    logic [26:0] fblk_d;
+
+    //padding
+    logic        last_blk_comb;  // hashing the last block
+    logic        last_fblk_comb; // prefetching the last block
+    logic [32:0] off_comb;      // byte offset of the word being received
+    logic [32:0] off_req_comb;  // byte offset of the word being requested
+    logic [26:0] pf_blk_comb;   // block to prefetch when the buffer is handed over
+    logic        pf_start_comb;
+    logic [31:0] fetch_word_comb; // fetched word with the padding, or the padding
+
+    //byte strings (BYTES): the message starts at any byte of IN_PTR and is
+    //stored in memory order. The words are read aligned; when the start is not,
+    //each block first reads the word holding its first byte into carry_q, and
+    //every message word joins carry_q with the next aligned word.
+    logic        bytes_q;
+    logic        bytes_d;
+    logic [31:0] carry_q;
+    logic [31:0] carry_d;
+    logic        prime_q;     // carry_q is not loaded yet for this block
+    logic        prime_d;
+    logic [31:0] in_addr_comb; // start of the message being fetched
+    logic [1:0]  fa_comb;     // its byte offset in the aligned word
+    logic        need_new_comb; // the message word takes bytes of the next aligned word
+    logic [63:0] join_comb;   // carry_q and the next aligned word
+    logic [31:0] src_le_comb; // message word, memory byte order
+    logic [31:0] src_word_comb; // message word, big-endian
+
     ////////////////////For the management of the signal, memory address, or hash////////////////////////
     acc_hw_req_t acc_hw_req_i;
     acc_hw_rsp_t acc_hw_rsp_o;
     
     logic [31:0] addr_inp_hand;
     logic [31:0] rdata_inp_hand; 
+    logic [31:0] len_inp_hand;
+    logic [31:0] ctrl_inp_hand;
+    logic [31:0] prelen_inp_hand;
     logic gnt_inp_hand; 
 
     logic start_mem_addr; // the signal for memory address
+    logic save_h;         // store the chaining value in H0..H7
+    logic save_ih;        // store the chaining value in IH0..IH7 / OH0..OH7
+    logic save_oh;
+    logic [31:0] h_save_comb [0:7];
     logic wdata_acc_i; // for polling
+    logic done_inp_hand;
 
     assign acc_hw_req_i.addr = addr_inp_hand;
     assign acc_hw_req_i.start_mem_addr = start_mem_addr;
+    assign acc_hw_req_i.save_h = save_h;
+    assign acc_hw_req_i.save_ih = save_ih;
+    assign acc_hw_req_i.save_oh = save_oh;
+    assign acc_hw_req_i.save_nonce = save_nonce;
+    assign acc_hw_req_i.nonce = nonce_save_comb;
+    assign acc_hw_req_i.found = found_q;
+    assign acc_hw_req_i.berr = berr_q;
+    assign acc_hw_req_i.ring_step = ring_step;
+    assign acc_hw_req_i.ring_irq = ring_irq;
+    assign acc_hw_req_i.ring_stop = ring_stop;
+    assign acc_hw_req_i.desc_we = desc_we;
+    assign acc_hw_req_i.desc_idx = coun_io_q[1:0];
+    assign acc_hw_req_i.desc_word = rdata_i;
+    assign acc_hw_req_i.perf_stall = (state_q == Fetch);
+    assign acc_hw_req_i.perf_gnt_wait = req_o_q && !gnt_i;
+    assign acc_hw_req_i.perf_wb = (state_q == Output);
+    assign acc_hw_req_i.perf_blocks = (state_q == Chank_load) ? nlane_q : 3'd0;
+    assign acc_hw_req_i.perf_job = job_end_comb;
+    for (genvar i = 0; i < 8; i++) begin : gen_save_h
+        assign acc_hw_req_i.h[i] = h_save_comb[i];
+    end
 
     assign rdata_inp_hand = acc_hw_rsp_o.rdata;
+    // a PIO message is at most the 16 words of the window
+    assign len_inp_hand = (acc_hw_rsp_o.ctrl[CTRL_PIO] && acc_hw_rsp_o.len > 32'd64)
+                          ? 32'd64 : acc_hw_rsp_o.len;
+    assign ctrl_inp_hand = acc_hw_rsp_o.ctrl;
+    assign prelen_inp_hand = acc_hw_rsp_o.prelen;
     assign gnt_inp_hand = acc_hw_rsp_o.gnt;
 
     assign rdata_i = user_mgr_obi_rsp_i.r.rdata;
@@ -97,83 +260,239 @@ import shapkg::*;
     assign user_mgr_obi_req_o.req = req_o_q;
 
 
-    input_handling input_handling (
+    input_handling #(
+        .NumLanes           ( NumLanes           )
+    ) input_handling (
         .rst_ni             ( rst_ni             ),
         .clk_i              ( clk_i              ),
         .wdata_acc_i        ( wdata_acc_i        ),
         .user_sbr_mem_req_i ( user_sbr_obi_req_i ),
         .user_sbr_mem_rsp_o ( user_sbr_obi_rsp_o ),
         .acc_hw_req_i       ( acc_hw_req_i       ),
-        .acc_hw_rsp_o       ( acc_hw_rsp_o       )
+        .acc_hw_rsp_o       ( acc_hw_rsp_o       ),
+        .done_o             ( done_inp_hand      )
     );
+
+    // Level interrupt: stays high while DONE is set, so it cannot be missed
+    // by a core that is busy or has interrupts masked; cleared by writing DONE = 0
+    assign irq = done_inp_hand;
     //////////////////////////////////UP TO HERE//////////////////////////////////
 
     // The main memory (Words memory, Hash value, Output memory, counter memory and some minor memory)
     always_ff @(posedge clk_i or negedge rst_ni) begin
         if (!rst_ni) begin
-            read_q <= 1'b0;
             req_o_q <= 1'b0;
             coun_h_q <= 0;
+            coun_req_q <= 0;
             coun_io_q <= 0;
+            len_q <= 0;
+            tlen_q <= 0;
+            nopad_q <= 1'b0;
+            key_q <= 1'b0;
+            hmac_q <= 1'b0;
+            outer_q <= 1'b0;
+            iter_q <= 0;
+            search_q <= 1'b0;
+            loadh_q <= 1'b0;
+            found_q <= 1'b0;
+            berr_q <= 1'b0;
+            nonce_q <= 0;
+            count_q <= 0;
+            ring_q <= 1'b0;
+            irqc_q <= 0;
+            pio_q <= 1'b0;
+            bytes_q <= 1'b0;
+            carry_q <= 0;
+            prime_q <= 1'b0;
+            nblk_q <= 0;
+            blk_q <= 0;
+            fblk_q <= 0;
+            pref_full_q <= 1'b0;
+            fetch_q <= 1'b0;
+            nlane_q <= 1;
+            flane_q <= 0;
+            fbase_q <= 0;
             state_q <= Idle;
-            for(int i =0; i < 16; i++) begin
-                words_q[i] <= 0;
-            end
+            for (int l = 0; l < NumLanes; l++) begin
+                for(int i =0; i < 16; i++) begin
+                    words_q[l][i] <= 0;
+                    pref_q[l][i] <= 0;
+                end
+                for (int r = 0; r < RoundsPerCycle; r++) begin
+                    hkw_q[l][r] <= 0;
+                end
 
-            ato_h_q <= SHA_IV;
+                ato_h_q[l] <= SHA_IV;
 
-            for(int i = 0; i < 8; i++) begin
-                hout_q[i] <= 0;
+                for(int i = 0; i < 8; i++) begin
+                    hout_q[l][i] <= 0;
+                end
             end
         end else begin
 
             //some values useful for input and output 
-            read_q <= read_d;
             req_o_q <= req_o_d;
 
             //counter
             coun_h_q <= coun_h_d;
+            coun_req_q <= coun_req_d;
             coun_io_q <= coun_io_d;
 
+            //message
+            len_q <= len_d;
+            tlen_q <= tlen_d;
+            nopad_q <= nopad_d;
+            key_q <= key_d;
+            hmac_q <= hmac_d;
+            outer_q <= outer_d;
+            iter_q <= iter_d;
+            search_q <= search_d;
+            loadh_q <= loadh_d;
+            found_q <= found_d;
+            berr_q <= berr_d;
+            nonce_q <= nonce_d;
+            count_q <= count_d;
+            ring_q <= ring_d;
+            irqc_q <= irqc_d;
+            pio_q <= pio_d;
+            bytes_q <= bytes_d;
+            carry_q <= carry_d;
+            prime_q <= prime_d;
+            nblk_q <= nblk_d;
+            blk_q <= blk_d;
+            fblk_q <= fblk_d;
+            pref_full_q <= pref_full_d;
+            fetch_q <= fetch_d;
+            nlane_q <= nlane_d;
+            flane_q <= flane_d;
+            fbase_q <= fbase_d;
+
             //state
             state_q <= state_d;
 
             //Words, H-value, e Output
             words_q <= words_d;
+            pref_q <= pref_d;
+            hkw_q <= hkw_d;
             ato_h_q <= ato_h_d;
             hout_q  <= hout_d;
         end
     end
 
-    // Create new words for hashing
-    MessageExpansion msg_expansion (
-        .wkk15_i    ( wkk15_comb   ),
-        .wkk2_i     ( wkk2_comb    ),
-        .wkk16_i    ( wkk16_comb   ),
-        .wkk7_i     ( wkk7_comb    ),
-        .wkk_o      ( wkk_new_comb )
-    );
+`ifndef SYNTHESIS
+    initial assert (RoundsPerCycle inside {1, 2, 4})
+        else $fatal(1, "ethz_sha2: RoundsPerCycle must be 1, 2 or 4");
+    initial assert (NumLanes inside {[1:4]})
+        else $fatal(1, "ethz_sha2: NumLanes must be 1 to 4");
+`endif
+
+    for (genvar l = 0; l < NumLanes; l++) begin : gen_lane
+        for (genvar i = 0; i < 16; i++) begin : gen_wkk_window
+            assign wkk_ext_comb[l][i] = words_q[l][i];
+        end
+
+        assign ato_h_chain_comb[l][0] = ato_h_q[l];
+
+        for (genvar r = 0; r < RoundsPerCycle; r++) begin : gen_round
+            // Create new words for hashing: W[t] from W[t-15], W[t-2], W[t-16] and
+            // W[t-7]; for r >= 2, W[t-2] is expanded earlier in the same cycle
+            MessageExpansion msg_expansion (
+                .wkk15_i    ( wkk_ext_comb[l][r+1]  ),
+                .wkk2_i     ( wkk_ext_comb[l][r+14] ),
+                .wkk16_i    ( wkk_ext_comb[l][r]    ),
+                .wkk7_i     ( wkk_ext_comb[l][r+9]  ),
+                .wkk_o      ( wkk_ext_comb[l][r+16] )
+            );
 
-    // Hash function
-    MainLoop main_loop (
-        .kkk_i      ( kkk_main_comb   ),
-        .wkk_i      ( wkk_main_comb   ),
-        .ato_h_i    ( ato_h_main_comb ),
-        .ato_h_o    ( ato_h_new_comb  )
+            // Hash function, chained round after round
+            MainLoop #(
+                .AddH       ( r + RoundsPerCycle > 3 )
+            ) main_loop (
+                .hkw_i      ( hkw_q[l][r]              ),
+                .ato_h_i    ( ato_h_chain_comb[l][r]   ),
+                .ato_h_o    ( ato_h_chain_comb[l][r+1] )
+            );
+        end
+    end
+
+    // Padding (FIPS 180-4, 5.1.1): the message words are big-endian, so the
+    // message continues with the 0x80 byte in the first free byte lane, zero
+    // words, and the bit length in words 14 and 15 of the last block.
+    // nblk leaves room for 0x80 and the length, so padding may spill into an
+    // extra block that holds no message bytes at all.
+    // Word idx at byte offset off of the padded message, data is the message
+    // word there (unused once off is past the message).
+    function automatic logic [31:0] padded_word(
+        input logic [31:0] data,
+        input logic [32:0] off,
+        input logic [3:0]  idx,
+        input logic        last,  // the word is in the last block
+        input logic [31:0] len,
+        input logic [31:0] tlen,
+        input logic        nopad
     );
+        logic [7:0]  pad_byte; // 0x80, or 0 without padding
+        logic [32:0] rem;      // message bytes left from off
+        pad_byte = nopad ? 8'h00 : 8'h80;
+        rem = {1'b0, len} - off;
+        if (off >= {1'b0, len}) begin
+            if (nopad) begin
+                return 32'b0;
+            end else if (last && idx == 14) begin
+                return {29'b0, tlen[31:29]};
+            end else if (last && idx == 15) begin
+                return {tlen[28:0], 3'b000};
+            end else if (off == {1'b0, len}) begin
+                return 32'h8000_0000;
+            end
+            return 32'b0;
+        end
+        case (rem)
+            33'd1:   return {data[31:24], pad_byte, 16'h0};
+            33'd2:   return {data[31:16], pad_byte,  8'h0};
+            33'd3:   return {data[31:8],  pad_byte};
+            default: return data;
+        endcase
+    endfunction
+
+    function automatic logic [31:0] bswap(input logic [31:0] word);
+        return {word[7:0], word[15:8], word[23:16], word[31:24]};
+    endfunction
+
+    // a + b + c + d as two carry-save levels and one carry-propagate add
+    function automatic logic [31:0] add4(input logic [31:0] a, input logic [31:0] b,
+                                         input logic [31:0] c, input logic [31:0] d);
+        logic [31:0] s0, m0, c0, s1, m1, c1;
+        s0 = a ^ b ^ c;
+        m0 = (a & b) | (a & c) | (b & c);
+        c0 = {m0[30:0], 1'b0};
+        s1 = s0 ^ c0 ^ d;
+        m1 = (s0 & c0) | (s0 & d) | (c0 & d);
+        c1 = {m1[30:0], 1'b0};
+        return s1 + c1;
+    endfunction
 
-    // For next chank
     always_comb begin
-        for (int i = 0; i < 16; i++) begin
-            if(i==0) begin 
-                next_chunk_comb[i] = 32'b10000000000000000000000000000000;
-            end else if(i==15) begin
-                next_chunk_comb[i] = 32'b00000000000000000000001000000000;
-            end else begin
-                next_chunk_comb[i] = 32'b000000000000000000000000000000;
-            end
+        last_blk_comb = (blk_q == nblk_q - 1);
+        last_fblk_comb = (fblk_q == nblk_q - 1);
+        off_comb = {fblk_q, coun_io_q[3:0], 2'b00};
+        off_req_comb = {fblk_q, 6'b0} + {coun_req_q[4:0], 2'b00};
+
+        // IN_PTR is on rdata_inp_hand while the prefetch engine runs
+        in_addr_comb = rdata_inp_hand + fbase_q;
+        fa_comb = bytes_q ? in_addr_comb[1:0] : 2'b00;
+        need_new_comb = (fa_comb == 0)
+                        || ({1'b0, len_q} - off_comb > {31'b0, 3'd4 - fa_comb});
+        join_comb = {need_new_comb ? rdata_i : 32'b0, carry_q};
+        if (fa_comb == 0) begin
+            src_le_comb = rdata_i;
+        end else begin
+            src_le_comb = 32'(join_comb >> {fa_comb, 3'b000});
         end
-    end  
+        src_word_comb = bytes_q ? bswap(src_le_comb) : rdata_i;
+        fetch_word_comb = padded_word(src_word_comb, off_comb, coun_io_q[3:0], last_fblk_comb,
+                                      len_q, tlen_q, nopad_q);
+    end
 
     // State transition and control logic
     always_comb begin
@@ -181,122 +500,567 @@ import shapkg::*;
         req_o_d = req_o_q;
         ato_h_d = ato_h_q;  
         coun_h_d = coun_h_q;
+        coun_req_d = coun_req_q;
         coun_io_d = coun_io_q; 
-        read_d = read_q;
+        len_d = len_q;
+        tlen_d = tlen_q;
+        nopad_d = nopad_q;
+        key_d = key_q;
+        hmac_d = hmac_q;
+        outer_d = outer_q;
+        iter_d = iter_q;
+        search_d = search_q;
+        loadh_d = loadh_q;
+        found_d = found_q;
+        berr_d = berr_q;
+        nonce_d = nonce_q;
+        count_d = count_q;
+        nonce_save_comb = nonce_q;
+        miss_comb = search_q && last_blk_comb
+                    && (ato_h_q[0][0] + hout_q[0][0] >= acc_hw_rsp_o.target);
+        save_nonce = 1'b0;
+        ring_d = ring_q;
+        irqc_d = irqc_q;
+        pio_d = pio_q;
+        bytes_d = bytes_q;
+        carry_d = carry_q;
+        prime_d = prime_q;
+        job_end_comb = 1'b0;
+        ring_step = 1'b0;
+        ring_irq = 1'b0;
+        ring_stop = 1'b0;
+        desc_we = 1'b0;
+        nblk_d = nblk_q;
+        blk_d = blk_q;
+        fblk_d = fblk_q;
+        pref_d = pref_q;
+        pref_full_d = pref_full_q;
+        fetch_d = fetch_q;
+        nlane_d = nlane_q;
+        flane_d = flane_q;
+        fbase_d = fbase_q;
+        pf_blk_comb = 0;
+        pf_start_comb = 1'b0;
         words_d = words_q;
         hout_d = hout_q ;
-        irq = 1'b0;
         we_o = 1'b0;  
         hout_o = 32'b0;
         start_mem_addr = 1'b0;
+        save_h = 1'b0;
+        save_ih = 1'b0;
+        save_oh = 1'b0;
+        h_save_comb = hout_q[0];
         addr_inp_hand = 32'b0;
         addr_o = 32'b0;
-        wkk15_comb = 0;
-        wkk2_comb = 0;
-        wkk16_comb = 0;
-        wkk7_comb = 0;
-        wkk_main_comb = 0;
         wdata_acc_i = 0;
-        kkk_main_comb = 0;
-        ato_h_main_comb = ato_h_q;
+        hkw_load_comb = 1'b0;
+        hkw_ff_comb = 1'b0;
+        hkw_round_comb = 1'b0;
+        for (int l = 0; l < NumLanes; l++) begin
+            for (int r = 0; r < RoundsPerCycle; r++) begin
+                k_nxt_comb[l][r] = 0;
+                w_nxt_comb[l][r] = 0;
+                wx_nxt_comb[l][r] = 0;
+            end
+        end
+
+        // Prefetch engine: loads block fblk of every lane into pref_q, lane
+        // after lane. Requests go out back-to-back, one per grant, as long as
+        // the words hold message bytes; responses are consumed as they arrive
+        // and the rest is padding.
+        if (fetch_q && pio_q && fblk_q == 0) begin
+            // PIO: the first block comes from the message window at once
+            for (int i = 0; i < 16; i++) begin
+                pref_d[0][i] = padded_word(bytes_q ? bswap(acc_hw_rsp_o.msg[i])
+                                                   : acc_hw_rsp_o.msg[i],
+                                           {27'b0, 4'(i), 2'b00}, 4'(i),
+                                           nblk_q == 1, len_q, tlen_q, nopad_q);
+            end
+            fetch_d = 1'b0;
+            pref_full_d = 1'b1;
+        end else if (fetch_q) begin
+            addr_inp_hand = 32'h2000_0000;
+            addr_o = {in_addr_comb[31:2], 2'b00} + off_req_comb[31:0];
+            if (req_o_q == 1 && gnt_i == 1) begin
+                // the next aligned word is in the block (one more when the
+                // start is unaligned) and holds message bytes
+                coun_req_d = coun_req_q + 1;
+                req_o_d = (coun_req_q != ((fa_comb != 0) ? 16 : 15))
+                          && (off_req_comb + 33'd4 < {1'b0, len_q} + fa_comb);
+            end
+            if (coun_io_q == 16 && flane_q + 1 < nlane_q) begin
+                // same block of the next lane's message
+                flane_d = flane_q + 1;
+                fbase_d = fbase_q + acc_hw_rsp_o.stride;
+                coun_io_d = 0;
+                coun_req_d = 0;
+                prime_d = 1'b1;
+                req_o_d = ({fblk_q, 6'b0} < {1'b0, len_q});
+            end else if (coun_io_q == 16) begin
+                coun_io_d = 0;
+                coun_req_d = 0;
+                fetch_d = 1'b0;
+                pref_full_d = 1'b1;
+            end else if (off_comb >= {1'b0, len_q}) begin
+                // no message bytes left in this word, nothing to read
+                pref_d[flane_q][coun_io_q[3:0]] = fetch_word_comb;
+                coun_io_d = coun_io_q + 1;
+            end else if (prime_q && fa_comb != 0) begin
+                // unaligned start: the first word of the block only fills carry
+                if (rvalid_i == 1) begin
+                    carry_d = rdata_i;
+                    prime_d = 1'b0;
+                end
+            end else if (rvalid_i == 1 || !need_new_comb) begin
+                // the last message word may lie in carry_q alone
+                pref_d[flane_q][coun_io_q[3:0]] = fetch_word_comb;
+                carry_d = rdata_i;
+                coun_io_d = coun_io_q + 1;
+            end
+        end
 
         case (state_q)
             Idle: begin
-                hout_d = ato_h_q;
-                if ((rvalid_i == 1 && err_i == 0 && coun_io_q < 16)) begin
-                    words_d[coun_io_q] = rdata_i; 
-                end 
-                addr_inp_hand = 32'h2000_0000;
-                if((gnt_inp_hand == 1 || read_q == 1)) begin
-                    hout_o = 0;
-                    if((rvalid_i == 1) && (err_i == 0) && (rid_i == 0) && (req_o_q == 1)) begin // rid_i == 0 if aid == 0
-                        coun_io_d = coun_io_q + 1;
-                        req_o_d = 1'b0;
-                    end else if((rvalid_i == 0) && (err_i == 0) && (rid_i == 5'b11111) && (gnt_i == 0) && (req_o_q == 1)) begin
-                        coun_io_d = coun_io_q;
-                        req_o_d = 1'b0;
+                // started by the core: take the length and begin with SHA_IV,
+                // or with the chaining value in H0..H7 to resume a hash. In
+                // ring mode the jobs start here once their descriptor is loaded
+                if (gnt_inp_hand == 1 && ctrl_inp_hand[CTRL_RING]) begin
+                    ring_d = 1'b1;
+                    irqc_d = 0;
+                    coun_req_d = 0;
+                    coun_io_d = 0;
+                    req_o_d = 1'b0;
+                    state_d = Desc;
+                end else if (gnt_inp_hand == 1 && ctrl_inp_hand[CTRL_SEARCH]
+                             && !ctrl_inp_hand[CTRL_KEY] && (len_inp_hand > 32'd55
+                             || acc_hw_rsp_o.nonce_idx > 32'd15
+                             || ctrl_inp_hand[CTRL_HMAC])) begin
+                    // the template is not one block with the nonce in it, or
+                    // HMAC would hash it twice: end without an attempt and
+                    // without a hit (DONE takes found_q, so a hit left from the
+                    // last job is cleared first)
+                    found_d = 1'b0;
+                    job_end_comb = !found_q;
+                end else if (gnt_inp_hand == 1) begin
+                    key_d = ctrl_inp_hand[CTRL_KEY];
+                    hmac_d = ctrl_inp_hand[CTRL_HMAC] && !ctrl_inp_hand[CTRL_KEY];
+                    outer_d = 1'b0;
+                    iter_d = acc_hw_rsp_o.iter;
+                    search_d = ctrl_inp_hand[CTRL_SEARCH] && !ctrl_inp_hand[CTRL_KEY];
+                    loadh_d = ctrl_inp_hand[CTRL_LOAD_H];
+                    found_d = 1'b0;
+                    nonce_d = acc_hw_rsp_o.nonce;
+                    count_d = acc_hw_rsp_o.count;
+                    pio_d = ctrl_inp_hand[CTRL_PIO];
+                    bytes_d = ctrl_inp_hand[CTRL_BYTES];
+                    len_d = len_inp_hand;
+                    // an HMAC message follows the 64-byte key block
+                    tlen_d = len_inp_hand + prelen_inp_hand
+                             + (ctrl_inp_hand[CTRL_HMAC] ? 32'd64 : 32'd0);
+                    nopad_d = ctrl_inp_hand[CTRL_NO_PAD] || ctrl_inp_hand[CTRL_KEY];
+                    if (ctrl_inp_hand[CTRL_KEY]) begin
+                        nblk_d = 1;   // the key, up to 64 bytes, zero filled
+                    end else if (ctrl_inp_hand[CTRL_NO_PAD]) begin
+                        nblk_d = len_inp_hand >> 6;
                     end else begin
-                        coun_io_d = coun_io_q;
-                        req_o_d = 1'b1;
-                    end 
-                    addr_o = rdata_inp_hand + (coun_io_q)*4;
-                    if(addr_inp_hand == 32'h2000_000C) begin
-                        wdata_acc_i = 0;
+                        nblk_d = ({1'b0, len_inp_hand} + 33'd8) >> 6;
+                        nblk_d = nblk_d + 1;
                     end
-                end else begin
-                    coun_io_d = coun_io_q;
+                    // key, search and PIO jobs are single messages
+                    if (ctrl_inp_hand[CTRL_KEY] || ctrl_inp_hand[CTRL_SEARCH]
+                        || ctrl_inp_hand[CTRL_PIO] || acc_hw_rsp_o.lanes == 0) begin
+                        nlane_d = 1;
+                    end else if (acc_hw_rsp_o.lanes > NumLanes) begin
+                        nlane_d = 3'(NumLanes);
+                    end else begin
+                        nlane_d = acc_hw_rsp_o.lanes[2:0];
+                    end
+                    blk_d = 0;
+                    for (int l = 0; l < NumLanes; l++) begin
+                        if (ctrl_inp_hand[CTRL_LOAD_H] && !ctrl_inp_hand[CTRL_KEY]) begin
+                            for (int i = 0; i < 8; i++) begin
+                                ato_h_d[l][i] = acc_hw_rsp_o.h[i];
+                                hout_d[l][i] = acc_hw_rsp_o.h[i];
+                            end
+                        end else if (ctrl_inp_hand[CTRL_HMAC] && !ctrl_inp_hand[CTRL_KEY]) begin
+                            for (int i = 0; i < 8; i++) begin
+                                ato_h_d[l][i] = acc_hw_rsp_o.ih[i];
+                                hout_d[l][i] = acc_hw_rsp_o.ih[i];
+                            end
+                        end else begin
+                            ato_h_d[l] = SHA_IV;
+                            hout_d[l] = SHA_IV;
+                        end
+                    end
+                    // prefetch the first block
+                    fblk_d = 0;
+                    fetch_d = 1'b1;
+                    flane_d = 0;
+                    fbase_d = 0;
+                    prime_d = 1'b1;
+                    pref_full_d = 1'b0;
+                    coun_req_d = 0;
+                    coun_io_d = 0;
+                    req_o_d = (len_inp_hand != 0) && !ctrl_inp_hand[CTRL_PIO];
+                    state_d = Fetch;
                 end
-                if(coun_io_q==17) begin
+            end
+            Fetch: begin
+                // only waits for the prefetch buffer: the rounds have caught up
+                if (pref_full_q) begin
+                    pf_blk_comb = blk_q + 1;
+                    pf_start_comb = 1'b1;
                     state_d = Hashing;
                 end
             end
             Hashing: begin
-                req_o_d = 1'b0;
-                read_d = 0;
-                coun_io_d= 0;
-                coun_h_d = coun_h_q + 1;  
-                if (((coun_h_q) % 65)> 15) begin
-                    wkk15_comb = words_q[1];
-                    wkk2_comb = words_q[14];
-                    wkk16_comb = words_q[0];
-                    wkk7_comb = words_q[9];
-                    wkk_main_comb = wkk_new_comb;
-                end else if (((coun_h_q) % 65) <= 15) begin
-                    wkk_main_comb = words_q[(coun_h_q) % 65];
-                end
-                if(((coun_h_q) % 65)>15) begin
-                    words_d[0:14] = words_q[1:15];
-                    words_d[15] = wkk_new_comb;
-                end
-                kkk_main_comb = K_INITIAL[(coun_h_q)%65];
-                ato_h_main_comb = ato_h_q;
-                ato_h_d = ato_h_new_comb;                 
-                if(coun_h_q == 64 || coun_h_q == 129) begin
-                    for(int i = 0; i<8; i++) begin
-                        hout_d[i] = ato_h_q[i] + hout_q[i];
+                // rounds t = coun_h * RoundsPerCycle + r of the block run on
+                // hkw_q; prepare K + W of the rounds of the next cycle
+                coun_h_d = coun_h_q + 1;
+                hkw_load_comb = 1'b1;
+                hkw_round_comb = 1'b1;
+                for (int l = 0; l < NumLanes; l++) begin
+                    ato_h_d[l] = ato_h_chain_comb[l][RoundsPerCycle];
+                    if (coun_h_q >= 16 / RoundsPerCycle - 1) begin
+                        // the window runs one cycle ahead: it expands the words of
+                        // the next cycle (16 is a multiple of RoundsPerCycle)
+                        for (int r = 0; r < RoundsPerCycle; r++) begin
+                            k_nxt_comb[l][r] = K_INITIAL[6'((coun_h_q + 1) * RoundsPerCycle + r)];
+                            w_nxt_comb[l][r] = wkk_ext_comb[l][16 + r];
+                        end
+                        for (int i = 0; i < 16; i++) begin
+                            words_d[l][i] = wkk_ext_comb[l][i + RoundsPerCycle];
+                        end
+                    end else begin
+                        for (int r = 0; r < RoundsPerCycle; r++) begin
+                            k_nxt_comb[l][r] = K_INITIAL[6'((coun_h_q + 1) * RoundsPerCycle + r)];
+                            w_nxt_comb[l][r] = words_q[l][4'((coun_h_q + 1) * RoundsPerCycle + r)];
+                        end
                     end
                 end
-                if(coun_h_q == 64) begin
+                if (coun_h_q == CyclesPerBlock - 1) begin
+                    coun_h_d = 0;
+                    hkw_load_comb = 1'b0;
                     state_d = Chank_load;
-                end else if(coun_h_q == 130) begin
-                    state_d = Output;
                 end
             end
             Chank_load: begin
-                words_d = next_chunk_comb;
-                ato_h_d = hout_q;
-                state_d = Hashing;
+                // add the block result to the chaining value and go on; if the
+                // next block is already prefetched the rounds continue at once.
+                // hkw of the next block takes ato_h_q and hout_q as operands,
+                // not their sum
+                hkw_ff_comb = 1'b1;
+                for (int l = 0; l < NumLanes; l++) begin
+                    for (int i = 0; i < 8; i++) begin
+                        hout_d[l][i] = ato_h_q[l][i] + hout_q[l][i];
+                        ato_h_d[l][i] = ato_h_q[l][i] + hout_q[l][i];
+                    end
+                end
+                for (int i = 0; i < 8; i++) begin
+                    h_save_comb[i] = ato_h_q[0][i] + hout_q[0][i];
+                end
+                blk_d = blk_q + 1;
+                if (berr_q && (last_blk_comb || outer_q)) begin
+                    // a read of the job failed and none is in flight any more:
+                    // end it without writing the digest, DONE reports the error
+                    job_end_comb = 1'b1;
+                    for (int l = 0; l < NumLanes; l++) begin
+                        ato_h_d[l] = SHA_IV;
+                    end
+                end else if (key_q && !outer_q) begin
+                    // key ^ ipad done: keep it as IH, then hash key ^ opad
+                    // from the prefetch buffer, which still holds the key
+                    save_ih = 1'b1;
+                    hkw_ff_comb = 1'b0;
+                    for (int l = 0; l < NumLanes; l++) begin
+                        ato_h_d[l] = SHA_IV;
+                        hout_d[l] = SHA_IV;
+                        for (int i = 0; i < 16; i++) begin
+                            words_d[l][i] = pref_q[l][i] ^ 32'h5c5c_5c5c;
+                        end
+                        for (int r = 0; r < RoundsPerCycle; r++) begin
+                            k_nxt_comb[l][r] = K_INITIAL[r];
+                            w_nxt_comb[l][r] = pref_q[l][r] ^ 32'h5c5c_5c5c;
+                        end
+                    end
+                    hkw_load_comb = 1'b1;
+                    outer_d = 1'b1;
+                    state_d = Hashing;
+                end else if (key_q) begin
+                    // key ^ opad done: keep it as OH, nothing is written out
+                    save_oh = 1'b1;
+                    job_end_comb = 1'b1;
+                    for (int l = 0; l < NumLanes; l++) begin
+                        ato_h_d[l] = SHA_IV;
+                    end
+                end else if (hmac_q && !outer_q && !nopad_q && last_blk_comb) begin
+                    // inner hash done: the outer hash is one block with the
+                    // inner digest, padded for 64 + 32 bytes, from OH
+                    hkw_ff_comb = 1'b0;
+                    for (int l = 0; l < NumLanes; l++) begin
+                        for (int i = 0; i < 8; i++) begin
+                            words_d[l][i] = ato_h_q[l][i] + hout_q[l][i];
+                            ato_h_d[l][i] = acc_hw_rsp_o.oh[i];
+                            hout_d[l][i] = acc_hw_rsp_o.oh[i];
+                        end
+                        words_d[l][8] = 32'h8000_0000;
+                        for (int i = 9; i < 15; i++) begin
+                            words_d[l][i] = 32'b0;
+                        end
+                        words_d[l][15] = 32'd768;
+                        for (int r = 0; r < RoundsPerCycle; r++) begin
+                            k_nxt_comb[l][r] = K_INITIAL[r];
+                            w_nxt_comb[l][r] = ato_h_q[l][r];
+                            wx_nxt_comb[l][r] = hout_q[l][r];
+                        end
+                    end
+                    hkw_load_comb = 1'b1;
+                    outer_d = 1'b1;
+                    state_d = Hashing;
+                end else if ((last_blk_comb || outer_q) && iter_q != 0 && !nopad_q) begin
+                    // iterate: the digest is the next message, one block padded
+                    // for 32 bytes (64 + 32 with the HMAC key block, from IH)
+                    iter_d = iter_q - 1;
+                    hkw_ff_comb = 1'b0;
+                    for (int l = 0; l < NumLanes; l++) begin
+                        for (int i = 0; i < 8; i++) begin
+                            words_d[l][i] = ato_h_q[l][i] + hout_q[l][i];
+                        end
+                        words_d[l][8] = 32'h8000_0000;
+                        for (int i = 9; i < 15; i++) begin
+                            words_d[l][i] = 32'b0;
+                        end
+                        words_d[l][15] = hmac_q ? 32'd768 : 32'd256;
+                        if (hmac_q) begin
+                            for (int i = 0; i < 8; i++) begin
+                                ato_h_d[l][i] = acc_hw_rsp_o.ih[i];
+                                hout_d[l][i] = acc_hw_rsp_o.ih[i];
+                            end
+                        end else begin
+                            ato_h_d[l] = SHA_IV;
+                            hout_d[l] = SHA_IV;
+                        end
+                        for (int r = 0; r < RoundsPerCycle; r++) begin
+                            k_nxt_comb[l][r] = K_INITIAL[r];
+                            w_nxt_comb[l][r] = ato_h_q[l][r];
+                            wx_nxt_comb[l][r] = hout_q[l][r];
+                        end
+                    end
+                    hkw_load_comb = 1'b1;
+                    blk_d = 0;
+                    nblk_d = 1;
+                    outer_d = 1'b0;
+                    state_d = Hashing;
+                end else if (miss_comb && count_q > 1) begin
+                    // miss: next nonce, same template block and start value
+                    // (a search job has one lane)
+                    nonce_d = nonce_q + 1;
+                    count_d = count_q - 1;
+                    iter_d = acc_hw_rsp_o.iter;
+                    words_d[0] = pref_q[0];
+                    words_d[0][acc_hw_rsp_o.nonce_idx[3:0]] = nonce_q + 1;
+                    if (loadh_q) begin
+                        for (int i = 0; i < 8; i++) begin
+                            ato_h_d[0][i] = acc_hw_rsp_o.h[i];
+                            hout_d[0][i] = acc_hw_rsp_o.h[i];
+                        end
+                    end else begin
+                        ato_h_d[0] = SHA_IV;
+                        hout_d[0] = SHA_IV;
+                    end
+                    hkw_load_comb = 1'b1;
+                    hkw_ff_comb = 1'b0;
+                    for (int r = 0; r < RoundsPerCycle; r++) begin
+                        k_nxt_comb[0][r] = K_INITIAL[r];
+                        w_nxt_comb[0][r] = words_d[0][r];
+                    end
+                    blk_d = 0;
+                    nblk_d = 1;
+                    state_d = Hashing;
+                end else if (miss_comb) begin
+                    // all attempts missed: NONCE is left at the next one to try,
+                    // nothing is written out
+                    nonce_save_comb = nonce_q + 1;
+                    save_nonce = 1'b1;
+                    job_end_comb = 1'b1;
+                    ato_h_d[0] = SHA_IV;
+                end else if (last_blk_comb || outer_q) begin
+                    // digest of the job, or the hit of a nonce search
+                    found_d = search_q;
+                    coun_req_d = 0;
+                    coun_io_d = 0;
+                    req_o_d = !pio_q;
+                    state_d = Output;
+                end else if (pref_full_q) begin
+                    pf_blk_comb = blk_q + 2;
+                    pf_start_comb = 1'b1;
+                    state_d = Hashing;
+                end else begin
+                    state_d = Fetch;
+                end
             end
 
             Output: begin
+                // the 8 digest words of every lane go out back-to-back, lane
+                // after lane, done after the last response; a PIO digest is
+                // only kept in H0..H7
                 we_o = 1'b1;
-                ato_h_d = ato_h_new_comb;
-                hout_o = hout_q[coun_io_q];
+                // a byte string digest is stored in memory order
+                hout_o = bytes_q ? bswap(hout_q[coun_req_q[4:3]][coun_req_q[2:0]])
+                                 : hout_q[coun_req_q[4:3]][coun_req_q[2:0]];
                 addr_inp_hand = 32'h2000_0004;
-                addr_o = rdata_inp_hand + (coun_io_q)*4;
-                if((rvalid_i == 1) && (err_i == 0) && (rid_i == 0) && (req_o_q == 1)) begin // rid_i == 0 if aid == 0
+                addr_o = rdata_inp_hand + {coun_req_q, 2'b00};
+                if (req_o_q == 1 && gnt_i == 1) begin
+                    coun_req_d = coun_req_q + 1;
+                    req_o_d = (coun_req_q != {nlane_q, 3'b000} - 1);
+                end
+                if (rvalid_i == 1) begin
                     coun_io_d = coun_io_q + 1;
-                    req_o_d = 1'b0;
-                end else if((rvalid_i == 0) && (err_i == 0) && (rid_i == 5'b11111) && (gnt_i == 0) && (req_o_q == 1)) begin
-                    coun_io_d = coun_io_q;
-                    req_o_d = 1'b0;
-                end else begin
-                    coun_io_d = coun_io_q;
-                    req_o_d = 1'b1;
-                end 
-                if(coun_io_q == 8) begin
-                    start_mem_addr = 1'b1;
-                    addr_inp_hand = 32'h2000_000C;
+                end
+                if (coun_io_q == {nlane_q, 3'b000} || pio_q) begin
+                    save_h = 1'b1;
+                    save_nonce = search_q;
+                    coun_req_d = 0;
                     coun_io_d = 0;
                     coun_h_d = 0;
-                    req_o_d = 1'b0;
-                    irq = 1; //for wfi()
+                    job_end_comb = 1'b1;
+                    for (int l = 0; l < NumLanes; l++) begin
+                        ato_h_d[l] = SHA_IV;
+                    end
+                end
+            end
+            Desc: begin
+                // ring mode: read the 4 words of the descriptor at HEAD into
+                // IN_PTR, LEN, OUT_PTR and CTRL, or stop once HEAD reaches TAIL
+                addr_o = acc_hw_rsp_o.ring_base + {acc_hw_rsp_o.ring_head[27:0], 4'b0000}
+                         + {coun_req_q, 2'b00};
+                if (req_o_q == 1 && gnt_i == 1) begin
+                    coun_req_d = coun_req_q + 1;
+                    req_o_d = (coun_req_q != 3);
+                end
+                if (rvalid_i == 1) begin
+                    desc_we = !err_i;
+                    coun_io_d = coun_io_q + 1;
+                end
+                if (coun_io_q == 4 && berr_q) begin
+                    // the descriptor could not be read: stop the ring there
+                    coun_req_d = 0;
+                    coun_io_d = 0;
+                    ring_d = 1'b0;
+                    start_mem_addr = 1'b1;
+                    addr_inp_hand = 32'h2000_000C;
                     wdata_acc_i = 1'b1;
-                    ato_h_d = SHA_IV;
                     state_d = Idle;
+                end else if (coun_io_q == 4) begin
+                    coun_req_d = 0;
+                    coun_io_d = 0;
+                    state_d = Idle;
+                end else if (coun_req_q == 0 && req_o_q == 0) begin
+                    if (acc_hw_rsp_o.ring_head == acc_hw_rsp_o.ring_tail) begin
+                        ring_d = 1'b0;
+                        ring_stop = 1'b1;
+                        start_mem_addr = 1'b1;
+                        addr_inp_hand = 32'h2000_000C;
+                        wdata_acc_i = 1'b1;
+                        state_d = Idle;
+                    end else begin
+                        req_o_d = 1'b1;
+                    end
                 end
             end
+            default: begin
+                state_d = Idle;
+            end
         endcase
+
+        // Hand the prefetched block to the rounds and start on the one after
+        // it, unless there is none
+        if (pf_start_comb) begin
+            words_d = pref_q;
+            for (int l = 0; l < NumLanes; l++) begin
+                if (key_q) begin
+                    for (int i = 0; i < 16; i++) begin
+                        words_d[l][i] = pref_q[l][i] ^ 32'h3636_3636;
+                    end
+                end
+                if (search_q) begin
+                    words_d[l][acc_hw_rsp_o.nonce_idx[3:0]] = nonce_q;
+                end
+                for (int r = 0; r < RoundsPerCycle; r++) begin
+                    k_nxt_comb[l][r] = K_INITIAL[r];
+                    w_nxt_comb[l][r] = words_d[l][r];
+                end
+            end
+            hkw_load_comb = 1'b1;
+            pref_full_d = 1'b0;
+            if (pf_blk_comb < nblk_q) begin
+                fblk_d = pf_blk_comb;
+                fetch_d = 1'b1;
+                flane_d = 0;
+                fbase_d = 0;
+                prime_d = 1'b1;
+                coun_req_d = 0;
+                coun_io_d = 0;
+                req_o_d = ({pf_blk_comb, 6'b0} < {1'b0, len_q});
+            end
+        end
+
+        // End of a job: set DONE and wait for the core, or in ring mode step
+        // HEAD, interrupt if the descriptor asks for it or RING_THRESH jobs
+        // have finished since the last one, and read the next descriptor. A
+        // bus error stops the ring with HEAD at the failed job.
+        if (job_end_comb && ring_q && !berr_q) begin
+            ring_step = 1'b1;
+            irqc_d = irqc_q + 1;
+            if (ctrl_inp_hand[CTRL_DESC_IRQ] || (acc_hw_rsp_o.ring_thresh != 0
+                && irqc_q + 1 >= acc_hw_rsp_o.ring_thresh)) begin
+                ring_irq = 1'b1;
+                irqc_d = 0;
+            end
+            coun_req_d = 0;
+            coun_io_d = 0;
+            req_o_d = 1'b0;
+            state_d = Desc;
+        end else if (job_end_comb) begin
+            ring_d = 1'b0;
+            start_mem_addr = 1'b1;
+            addr_inp_hand = 32'h2000_000C;
+            wdata_acc_i = 1'b1;
+            state_d = Idle;
+        end
+
+        // DONE takes berr_q in the cycle START is cleared, the next job starts
+        // without it
+        if (start_mem_addr) begin
+            berr_d = 1'b0;
+        end
+        if (rvalid_i && err_i) begin
+            berr_d = 1'b1;
+        end
+
+        // h of the next cycle's rounds is in the next state, so it is added
+        // here and the rounds start from a single precomputed operand. While
+        // hashing h comes late from the rounds and K + W is added alongside;
+        // otherwise h is a register (at a block boundary the feed-forward
+        // ato_h_q + hout_q, as two operands) and all operands go through one
+        // carry-save tree (wx is only used where hout is not)
+        hkw_d = hkw_q;
+        if (hkw_load_comb) begin
+            for (int l = 0; l < NumLanes; l++) begin
+                for (int r = 0; r < RoundsPerCycle; r++) begin
+                    if (r + RoundsPerCycle <= 3 && hkw_round_comb) begin
+                        hkw_d[l][r] = ato_h_d[l][7 - r] + (k_nxt_comb[l][r] + w_nxt_comb[l][r]);
+                    end else if (r + RoundsPerCycle <= 3) begin
+                        hkw_d[l][r] = add4(hkw_ff_comb ? ato_h_q[l][7 - r] : ato_h_d[l][7 - r],
+                                           hkw_ff_comb ? hout_q[l][7 - r] : wx_nxt_comb[l][r],
+                                           k_nxt_comb[l][r], w_nxt_comb[l][r]);
+                    end else begin
+                        hkw_d[l][r] = add4(k_nxt_comb[l][r], w_nxt_comb[l][r],
+                                           wx_nxt_comb[l][r], 32'b0);
+                    end
+                end
+            end
+        end
     end
 
-endmodule
\ No newline at end of file
+endmodule
@@ -6,47 +6,88 @@
     
     module input_handling
     import shapkg::*;
-     (
+    #(
+        parameter int unsigned NumLanes = 1     // read back in LANES_MAX
+    )(
         input   logic           clk_i,          
         input   logic           rst_ni,
         input   logic           wdata_acc_i,    
         output  sbr_obi_rsp_t   user_sbr_mem_rsp_o, 
         input   sbr_obi_req_t   user_sbr_mem_req_i,
         input   acc_hw_req_t    acc_hw_req_i,
-        output  acc_hw_rsp_t    acc_hw_rsp_o
+        output  acc_hw_rsp_t    acc_hw_rsp_o,
+        output  logic           done_o          // DONE register, held until the core clears it
     );
-    logic [31:0] mem_addr_q [0:3];
-    logic [31:0] mem_addr_d [0:3]; 
+    // 0x00 IN_PTR, 0x04 OUT_PTR, 0x08 START, 0x0C DONE, 0x10 LEN (bytes),
+    // 0x14 CTRL, 0x18 PRE_LEN (bytes), 0x1C ITER, 0x20-0x3C H0..H7,
+    // 0x40-0x5C IH0..IH7, 0x60-0x7C OH0..OH7 (HMAC key midstates),
+    // 0x80 NONCE, 0x84 COUNT, 0x88 TARGET, 0x8C NONCE_IDX (nonce search),
+    // 0x90 LANES, 0x94 STRIDE (bytes), 0x98 LANES_MAX (read only),
+    // 0x9C RING_BASE, 0xA0 RING_SIZE, 0xA4 RING_HEAD, 0xA8 RING_TAIL,
+    // 0xAC RING_COUNT, 0xB0 RING_THRESH (descriptor ring),
+    // 0xC0-0xFC MSG0..MSG15 (PIO message window); 0xB4-0xBC read as 0
+    logic [31:0] mem_addr_q [0:63];
+    logic [31:0] mem_addr_d [0:63]; 
+
+    // 0x100 PERF_BUSY, 0x104 PERF_STALL, 0x108 PERF_GNT_WAIT, 0x10C PERF_WB,
+    // 0x110 PERF_BLOCKS, 0x114 PERF_JOBS (performance counters)
+    logic [31:0] perf_q [0:5];
+    logic [31:0] perf_d [0:5];
 
     logic [31:0] wdata_croc;
     logic [31:0] rdata_croc;
     logic [31:0] rdata_acc;
     logic [31:0] addr_croc;
+    logic [11:0] off_croc;      // offset in the 4 KB register window of this instance
     logic [31:0] addr_acc;
     logic [2:0]  aid_croc;
     logic [4:0]  we_croc;
     logic [3:0]  be_croc;
+    logic [31:0] be_mask_croc;  // bytes written by the core
     logic        req_croc;
     logic        gnt_croc;
     logic        gnt_acc;
-    logic        err_croc;
+    logic        err_croc;      // offset outside the register map, answered with err
+    logic        err_croc_q;    // error of the access answered in this cycle
     logic        rvalid_croc_q;
     logic        rvalid_croc_d;
     logic        check;
     logic [31:0] index_croc;
     logic [31:0] index_acc;
-    logic        bits_for_rdata_q;
-    logic        bits_for_rdata_d;
+    logic        wr_reg_croc;   // address is a register the core may write
+    logic        live_croc;     // DONE or ring register, accessible while a job runs
+    logic        live_wr_croc;  // DONE or RING_TAIL, writable while a job runs
+    logic        perf_croc;     // address is a performance counter
+    logic        rd_perf_q;     // last granted access was a counter read
+    logic        rd_perf_d;
+    logic [2:0]  rd_perf_idx_q;
+    logic [2:0]  rd_perf_idx_d;
+    logic        rd_reg_q;      // last granted access was a register read
+    logic        rd_reg_d;
+    logic [5:0]  rd_index_q;    // and this is the register
+    logic [5:0]  rd_index_d;
     logic        start_mem_addr;
+    logic        ring_idle_q;   // the ring drained, a RING_TAIL write restarts it
+    logic        ring_idle_d;
 
     //
     always_ff @(posedge clk_i or negedge rst_ni) begin
         if (!rst_ni) begin
-            bits_for_rdata_q <= 1'b0;
+            rd_reg_q <= 1'b0;
+            rd_index_q <= 6'b0;
+            rd_perf_q <= 1'b0;
+            rd_perf_idx_q <= 3'b0;
             rvalid_croc_q <= 1'b0;
+            err_croc_q <= 1'b0;
+            ring_idle_q <= 1'b0;
         end else begin
-            bits_for_rdata_q <= bits_for_rdata_d;
+            rd_reg_q <= rd_reg_d;
+            rd_index_q <= rd_index_d;
+            rd_perf_q <= rd_perf_d;
+            rd_perf_idx_q <= rd_perf_idx_d;
             rvalid_croc_q <= rvalid_croc_d;
+            err_croc_q <= gnt_croc && err_croc;
+            ring_idle_q <= ring_idle_d;
         end
     end
 
@@ -57,11 +98,33 @@
             mem_addr_q[1] <= 32'b0;
             mem_addr_q[2] <= 32'b0;
             mem_addr_q[3] <= 32'b0;
+            mem_addr_q[4] <= 32'd64; // one block, as before LEN existed
+            for (int i = 5; i < 36; i++) begin
+                mem_addr_q[i] <= 32'b0;
+            end
+            mem_addr_q[36] <= 32'd1;
+            mem_addr_q[37] <= 32'd64;
+            mem_addr_q[38] <= NumLanes;
+            for (int i = 39; i < 64; i++) begin
+                mem_addr_q[i] <= 32'b0;
+            end
         end else begin
             mem_addr_q <= mem_addr_d;
         end
     end
 
+    assign done_o = mem_addr_q[3][0];
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (!rst_ni) begin
+            for (int i = 0; i < 6; i++) begin
+                perf_q[i] <= 32'b0;
+            end
+        end else begin
+            perf_q <= perf_d;
+        end
+    end
+
     //reset check
     always_comb begin
         if(start_mem_addr) begin
@@ -73,12 +136,13 @@
 
     // Management of request and response signals
     always_comb begin
-        bits_for_rdata_d = bits_for_rdata_q;
         //input croc
         wdata_croc = user_sbr_mem_req_i.a.wdata;
         we_croc = user_sbr_mem_req_i.a.we;
         be_croc = user_sbr_mem_req_i.a.be;
+        be_mask_croc = {{8{be_croc[3]}}, {8{be_croc[2]}}, {8{be_croc[1]}}, {8{be_croc[0]}}};
         addr_croc = user_sbr_mem_req_i.a.addr;
+        off_croc = addr_croc[11:0];
         aid_croc = user_sbr_mem_req_i.a.aid;
         req_croc = user_sbr_mem_req_i.req;
 
@@ -86,15 +150,28 @@
         addr_acc = acc_hw_req_i.addr;
         start_mem_addr = acc_hw_req_i.start_mem_addr;
 
-        //error handling
-        err_croc = req_croc && (be_croc != 4'b1111 || addr_croc < 32'h2000_0000 || addr_croc >= 32'h2000_1000);
-        
-        //gnt_mem and gnt_acc handling
-        if(check == 0) begin
+        //the user domain demux only forwards the window of this instance, so
+        //the core side is decoded on the offset; byte and halfword writes only
+        //change their bytes. Offsets past the counters are answered with an
+        //error at once, also while a job runs
+        perf_croc = off_croc >= 12'h100 && off_croc < 12'h118;
+        err_croc = !(off_croc < 12'h100 || perf_croc);
+        live_croc = off_croc == 12'h00C || off_croc == 12'h0A4
+                 || off_croc == 12'h0A8 || off_croc == 12'h0AC || perf_croc || err_croc;
+        live_wr_croc = off_croc == 12'h00C || off_croc == 12'h0A8;
+
+        //gnt_mem and gnt_acc handling: while a job runs only DONE, the ring
+        //registers and the counters are served, so the core can append to a
+        //running ring and sample the counters. Nothing is granted in the cycle
+        //the job ends, its register updates would override the core's write
+        if (start_mem_addr) begin
+            gnt_croc = 1'b0;
+            gnt_acc = 1'b0;
+        end else if(check == 0) begin
             gnt_croc = (1'b1 && req_croc);
             gnt_acc = 1'b0;
         end else if(check == 1)begin
-            gnt_croc = 1'b0;
+            gnt_croc = req_croc && live_croc;
             gnt_acc = 1'b1;
         end else begin //for X o Z cases
             gnt_croc = (1'b1 && req_croc);
@@ -102,12 +179,23 @@
         end 
         
 
-        if ((we_croc == 0 && err_croc == 0 && addr_croc == 32'h2000_000C) || (bits_for_rdata_q && rvalid_croc_q)) begin
-            rdata_croc = mem_addr_q[3];
-            bits_for_rdata_d = 1'b1;
+        wr_reg_croc = (off_croc < 12'h00C)
+                   || (off_croc >= 12'h010 && off_croc < 12'h098)
+                   || (off_croc >= 12'h09C && off_croc < 12'h0B4)
+                   || (off_croc >= 12'h0C0 && off_croc < 12'h100);
+
+        // reads return the register in the response cycle, so DONE and H0..H7
+        // are seen as they are when rvalid is high
+        rd_reg_d = gnt_croc && we_croc == 0 && err_croc == 0 && off_croc < 12'h100;
+        rd_index_d = off_croc[7:2];
+        rd_perf_d = gnt_croc && we_croc == 0 && err_croc == 0 && perf_croc;
+        rd_perf_idx_d = off_croc[4:2];
+        if (rd_reg_q && rvalid_croc_q) begin
+            rdata_croc = mem_addr_q[rd_index_q];
+        end else if (rd_perf_q && rvalid_croc_q) begin
+            rdata_croc = perf_q[rd_perf_idx_q];
         end else begin
             rdata_croc = 32'b0;
-            bits_for_rdata_d = 1'b0;
         end
 
         rvalid_croc_d = gnt_croc;
@@ -115,13 +203,35 @@
         //output croc
         user_sbr_mem_rsp_o.r.rdata = rdata_croc;
         user_sbr_mem_rsp_o.r.rid = aid_croc;
-        user_sbr_mem_rsp_o.r.err = err_croc;
+        user_sbr_mem_rsp_o.r.err = err_croc_q;
         user_sbr_mem_rsp_o.r.r_optional = 1'b0;
         user_sbr_mem_rsp_o.gnt = gnt_croc;
         user_sbr_mem_rsp_o.rvalid = rvalid_croc_q;
 
         //output acc
         acc_hw_rsp_o.rdata = rdata_acc;
+        acc_hw_rsp_o.len = mem_addr_q[4];
+        acc_hw_rsp_o.ctrl = mem_addr_q[5];
+        acc_hw_rsp_o.prelen = mem_addr_q[6];
+        acc_hw_rsp_o.iter = mem_addr_q[7];
+        acc_hw_rsp_o.nonce = mem_addr_q[32];
+        acc_hw_rsp_o.count = mem_addr_q[33];
+        acc_hw_rsp_o.target = mem_addr_q[34];
+        acc_hw_rsp_o.nonce_idx = mem_addr_q[35];
+        acc_hw_rsp_o.lanes = mem_addr_q[36];
+        acc_hw_rsp_o.stride = mem_addr_q[37];
+        acc_hw_rsp_o.ring_base = mem_addr_q[39];
+        acc_hw_rsp_o.ring_head = mem_addr_q[41];
+        acc_hw_rsp_o.ring_tail = mem_addr_q[42];
+        acc_hw_rsp_o.ring_thresh = mem_addr_q[44];
+        for (int i = 0; i < 8; i++) begin
+            acc_hw_rsp_o.h[i] = mem_addr_q[8 + i];
+            acc_hw_rsp_o.ih[i] = mem_addr_q[16 + i];
+            acc_hw_rsp_o.oh[i] = mem_addr_q[24 + i];
+        end
+        for (int i = 0; i < 16; i++) begin
+            acc_hw_rsp_o.msg[i] = mem_addr_q[48 + i];
+        end
         acc_hw_rsp_o.gnt = gnt_acc;
 
     end
@@ -137,9 +247,11 @@
             index_acc = 0;
             rdata_acc = 0;
         end else begin 
-           if(err_croc == 0 && check == 0 && req_croc == 1 && (addr_croc < 32'h2000_000C)) begin
-                index_croc= (addr_croc - 32'h2000_0000) >> 2;
-                mem_addr_d[index_croc] = wdata_croc;
+           if(err_croc == 0 && (check == 0 || live_wr_croc) && req_croc == 1 && we_croc == 1
+              && wr_reg_croc) begin
+                index_croc= off_croc >> 2;
+                mem_addr_d[index_croc] = (mem_addr_q[index_croc] & ~be_mask_croc)
+                                         | (wdata_croc & be_mask_croc);
            end else begin
                 index_croc = 0;
                 mem_addr_d = mem_addr_q;
@@ -154,11 +266,92 @@
         end
 
         if(addr_acc == 32'h2000_000C && check == 0) begin
-            mem_addr_d[3] = wdata_acc_i;
-        end else if (we_croc == 1 && err_croc == 0 && addr_croc == 32'h2000_000C) begin
-            mem_addr_d[3] = wdata_croc;  
+            mem_addr_d[3] = {29'b0, acc_hw_req_i.berr, acc_hw_req_i.found, wdata_acc_i};
+        end else if (gnt_croc && we_croc == 1 && err_croc == 0 && off_croc == 12'h00C) begin
+            mem_addr_d[3] = (mem_addr_q[3] & ~be_mask_croc) | (wdata_croc & be_mask_croc);  
         end
 
+        // chaining value of the finished job, to be read back or resumed
+        if (acc_hw_req_i.save_h) begin
+            for (int i = 0; i < 8; i++) begin
+                mem_addr_d[8 + i] = acc_hw_req_i.h[i];
+            end
+        end
+        if (acc_hw_req_i.save_ih) begin
+            for (int i = 0; i < 8; i++) begin
+                mem_addr_d[16 + i] = acc_hw_req_i.h[i];
+            end
+        end
+        if (acc_hw_req_i.save_oh) begin
+            for (int i = 0; i < 8; i++) begin
+                mem_addr_d[24 + i] = acc_hw_req_i.h[i];
+            end
+        end
+        if (acc_hw_req_i.save_nonce) begin
+            mem_addr_d[32] = acc_hw_req_i.nonce;
+        end
+
+        // descriptor ring: a descriptor is IN_PTR, LEN, OUT_PTR and CTRL
+        if (acc_hw_req_i.desc_we) begin
+            case (acc_hw_req_i.desc_idx)
+                2'd0: mem_addr_d[0] = acc_hw_req_i.desc_word;
+                2'd1: mem_addr_d[4] = acc_hw_req_i.desc_word;
+                2'd2: mem_addr_d[1] = acc_hw_req_i.desc_word;
+                default: begin
+                    mem_addr_d[5] = acc_hw_req_i.desc_word;
+                    mem_addr_d[5][CTRL_RING] = 1'b0;
+                end
+            endcase
+        end
+        if (acc_hw_req_i.ring_step) begin
+            mem_addr_d[41] = (mem_addr_q[41] + 1 == mem_addr_q[40]) ? 32'b0 : mem_addr_q[41] + 1;
+            mem_addr_d[43] = mem_addr_q[43] + 1;
+        end
+        // set after the core's write, so a coalesced interrupt is not lost
+        if (acc_hw_req_i.ring_irq) begin
+            mem_addr_d[3][0] = 1'b1;
+        end
+        // a RING_TAIL write to a drained ring that leaves descriptors to run
+        // starts it again, so an append that loses the race with the drain
+        // still runs; any other start or ring setup ends this
+        ring_idle_d = ring_idle_q || acc_hw_req_i.ring_stop;
+        if (gnt_croc && we_croc == 1 && err_croc == 0 && check == 0) begin
+            if (off_croc == 12'h0A8 && ring_idle_q && mem_addr_d[42] != mem_addr_q[41]) begin
+                mem_addr_d[2][0] = 1'b1;
+                mem_addr_d[5][CTRL_RING] = 1'b1;
+                ring_idle_d = 1'b0;
+            end else if (off_croc == 12'h008 || off_croc == 12'h014
+                         || (off_croc >= 12'h09C && off_croc < 12'h0A8)) begin
+                ring_idle_d = 1'b0;
+            end
+        end
+
+    end
+
+    // Performance counters: they count while the engine runs and a write by
+    // the core sets one, so writing 0 resets it
+    always_comb begin
+        perf_d = perf_q;
+        if (mem_addr_q[2][0]) begin
+            perf_d[0] = perf_q[0] + 1;
+        end
+        if (acc_hw_req_i.perf_stall) begin
+            perf_d[1] = perf_q[1] + 1;
+        end
+        if (acc_hw_req_i.perf_gnt_wait) begin
+            perf_d[2] = perf_q[2] + 1;
+        end
+        if (acc_hw_req_i.perf_wb) begin
+            perf_d[3] = perf_q[3] + 1;
+        end
+        perf_d[4] = perf_q[4] + acc_hw_req_i.perf_blocks;
+        if (acc_hw_req_i.perf_job) begin
+            perf_d[5] = perf_q[5] + 1;
+        end
+        if (gnt_croc && we_croc == 1 && err_croc == 0 && perf_croc) begin
+            perf_d[off_croc[4:2]] = (perf_q[off_croc[4:2]] & ~be_mask_croc)
+                                   | (wdata_croc & be_mask_croc);
+        end
     end
 
 endmodule
\ No newline at end of file
@@ -42,6 +42,17 @@ package shapkg;
         32'h6a09e667 ,  32'hbb67ae85 ,  32'h3c6ef372 ,  32'ha54ff53a ,  32'h510e527f ,  32'h9b05688c ,  32'h1f83d9ab , 32'h5be0cd19
     };
 
+    // CTRL register bits
+    localparam int unsigned CTRL_LOAD_H = 0; // start from H0..H7 instead of SHA_IV
+    localparam int unsigned CTRL_NO_PAD = 1; // LEN is a multiple of 64, no padding
+    localparam int unsigned CTRL_HMAC   = 2; // inner hash from IH0..IH7, then outer hash from OH0..OH7
+    localparam int unsigned CTRL_KEY    = 3; // load an HMAC key: IH/OH from the key at IN_PTR
+    localparam int unsigned CTRL_SEARCH = 4; // nonce search over the one-block template at IN_PTR
+    localparam int unsigned CTRL_RING   = 5; // run the jobs of the descriptor ring
+    localparam int unsigned CTRL_PIO    = 6; // message from MSG0..MSG15, digest only in H0..H7
+    localparam int unsigned CTRL_BYTES  = 7; // byte string at any address, digest in byte order
+    localparam int unsigned CTRL_DESC_IRQ = 31; // descriptor: interrupt when this job is done
+
     // Width of hash
     localparam integer HWIDTH = 256;
 
@@ -140,6 +151,25 @@ package shapkg;
     typedef struct packed {
         logic [  SbrObiCfg.AddrWidth-1:0] addr;
         logic                             start_mem_addr;
+        logic                             save_h;  // store h in H0..H7
+        logic                             save_ih; // store h in IH0..IH7
+        logic                             save_oh; // store h in OH0..OH7
+        logic                             save_nonce; // store nonce in NONCE
+        logic                             found;   // nonce search hit, DONE bit 1
+        logic                             berr;    // bus error in the job, DONE bit 2
+        logic                             ring_step; // advance RING_HEAD and RING_COUNT
+        logic                             ring_irq;  // set DONE while the ring goes on
+        logic                             ring_stop; // the ring drained at RING_TAIL
+        logic                             desc_we;   // descriptor word desc_idx arrived
+        logic [1:0]                       desc_idx;
+        logic [SbrObiCfg.DataWidth-1:0]   desc_word;
+        logic                             perf_stall;    // rounds wait for message data
+        logic                             perf_gnt_wait; // manager request not granted
+        logic                             perf_wb;       // digest write-back
+        logic [2:0]                       perf_blocks;   // blocks compressed this cycle
+        logic                             perf_job;      // job done
+        logic [SbrObiCfg.DataWidth-1:0]   nonce;
+        logic [7:0][SbrObiCfg.DataWidth-1:0] h;    // chaining value at the end of the job
     } acc_hw_req_t;
 
 
@@ -147,6 +177,24 @@ package shapkg;
 
     typedef struct packed {
         logic [SbrObiCfg.DataWidth-1:0] rdata;
+        logic [SbrObiCfg.DataWidth-1:0] len;   // message length in bytes
+        logic [SbrObiCfg.DataWidth-1:0] ctrl;
+        logic [SbrObiCfg.DataWidth-1:0] prelen; // bytes hashed before this job
+        logic [SbrObiCfg.DataWidth-1:0] iter;   // times the digest is hashed again
+        logic [SbrObiCfg.DataWidth-1:0] nonce;  // nonce search: first nonce,
+        logic [SbrObiCfg.DataWidth-1:0] count;  // number of attempts,
+        logic [SbrObiCfg.DataWidth-1:0] target; // hit when H0 of the digest is below it,
+        logic [SbrObiCfg.DataWidth-1:0] nonce_idx; // word of the block that holds the nonce
+        logic [SbrObiCfg.DataWidth-1:0] lanes;  // messages of the job,
+        logic [SbrObiCfg.DataWidth-1:0] stride; // bytes from one message to the next
+        logic [SbrObiCfg.DataWidth-1:0] ring_base;   // descriptor ring: address,
+        logic [SbrObiCfg.DataWidth-1:0] ring_head;   // next descriptor to run,
+        logic [SbrObiCfg.DataWidth-1:0] ring_tail;   // one past the last one,
+        logic [SbrObiCfg.DataWidth-1:0] ring_thresh; // jobs per interrupt (0: when drained)
+        logic [15:0][SbrObiCfg.DataWidth-1:0] msg; // PIO message window
+        logic [7:0][SbrObiCfg.DataWidth-1:0] h; // chaining value to start from (CTRL_LOAD_H)
+        logic [7:0][SbrObiCfg.DataWidth-1:0] ih; // HMAC inner and outer key midstates
+        logic [7:0][SbrObiCfg.DataWidth-1:0] oh;
         logic                           gnt;
     } acc_hw_rsp_t;
 
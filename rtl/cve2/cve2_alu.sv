@@ -7,7 +7,8 @@
  * Arithmetic logic unit
  */
 module cve2_alu #(
-  parameter cve2_pkg::rv32b_e RV32B = cve2_pkg::RV32BNone
+  parameter cve2_pkg::rv32b_e RV32B = cve2_pkg::RV32BNone,
+  parameter bit               RV32Zk = 1'b0
 ) (
   input  cve2_pkg::alu_op_e operator_i,
   input  logic [31:0]       operand_a_i,
@@ -984,7 +985,20 @@ module cve2_alu #(
         endcase
       end
     end else begin : gen_alu_rvb_not_otearlgrey_full
-      assign shuffle_result       = '0;
+      if (RV32Zk) begin : gen_alu_zbkb_zip
+        // zip / unzip of Zbkb: the shuffles with control value 15, which interleave
+        // the halfwords bit by bit
+        logic [31:0] zip_result, unzip_result;
+        for (genvar i = 0; i < 16; i++) begin : gen_zip
+          assign zip_result[2*i]     = operand_a_i[i];
+          assign zip_result[2*i+1]   = operand_a_i[i+16];
+          assign unzip_result[i]     = operand_a_i[2*i];
+          assign unzip_result[i+16]  = operand_a_i[2*i+1];
+        end
+        assign shuffle_result = (operator_i == ALU_UNSHFL) ? unzip_result : zip_result;
+      end else begin : gen_alu_no_zbkb_zip
+        assign shuffle_result     = '0;
+      end
       assign xperm_result         = '0;
       assign clmul_result         = '0;
       // support signals
@@ -1312,6 +1326,32 @@ module cve2_alu #(
     assign imd_val_we_o        = '{default: '0};
   end
 
+  ////////////////////
+  // SHA-256 (Zknh) //
+  ////////////////////
+
+  logic [31:0] sha256_result;
+
+  if (RV32Zk) begin : g_alu_zknh
+    logic [31:0] a;
+    assign a = operand_a_i;
+
+    always_comb begin
+      unique case (operator_i)
+        ALU_SHA256_SUM0: sha256_result = {a[ 1:0], a[31: 2]} ^ {a[12:0], a[31:13]} ^
+                                         {a[21:0], a[31:22]};
+        ALU_SHA256_SUM1: sha256_result = {a[ 5:0], a[31: 6]} ^ {a[10:0], a[31:11]} ^
+                                         {a[24:0], a[31:25]};
+        ALU_SHA256_SIG0: sha256_result = {a[ 6:0], a[31: 7]} ^ {a[17:0], a[31:18]} ^
+                                         {3'b0, a[31: 3]};
+        default:         sha256_result = {a[16:0], a[31:17]} ^ {a[18:0], a[31:19]} ^
+                                         {10'b0, a[31:10]}; // ALU_SHA256_SIG1
+      endcase
+    end
+  end else begin : g_no_alu_zknh
+    assign sha256_result = '0;
+  end
+
   ////////////////
   // Result mux //
   ////////////////
@@ -1390,6 +1430,10 @@ module cve2_alu #(
       ALU_CLMUL, ALU_CLMULR,
       ALU_CLMULH: result_o = clmul_result;
 
+      // SHA-256 sigma functions (Zknh)
+      ALU_SHA256_SUM0, ALU_SHA256_SUM1,
+      ALU_SHA256_SIG0, ALU_SHA256_SIG1: result_o = sha256_result;
+
       default: ;
     endcase
   end
@@ -15,6 +15,7 @@ module cve2_core_tracing import cve2_pkg::*; #(
   parameter bit          RV32E             = 1'b0,
   parameter rv32m_e      RV32M             = RV32MFast,
   parameter rv32b_e      RV32B             = RV32BNone,
+  parameter bit          RV32Zk            = 1'b0,
   parameter bit          DbgTriggerEn      = 1'b0,
   parameter int unsigned DbgHwBreakNum     = 1,
   parameter int unsigned DmHaltAddr        = 32'h1A110800,
@@ -121,6 +122,7 @@ module cve2_core_tracing import cve2_pkg::*; #(
     .RV32E             (RV32E),
     .RV32M             (RV32M),
     .RV32B             (RV32B),
+    .RV32Zk            (RV32Zk),
     .DbgTriggerEn      (DbgTriggerEn),
     .DbgHwBreakNum     (DbgHwBreakNum),
     .DmHaltAddr        (DmHaltAddr),
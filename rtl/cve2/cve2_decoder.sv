@@ -16,7 +16,9 @@
 module cve2_decoder #(
   parameter bit RV32E               = 0,
   parameter cve2_pkg::rv32m_e RV32M = cve2_pkg::RV32MFast,
-  parameter cve2_pkg::rv32b_e RV32B = cve2_pkg::RV32BNone
+  parameter cve2_pkg::rv32b_e RV32B = cve2_pkg::RV32BNone,
+  // Scalar crypto: Zknh, and with RV32B != RV32BNone the rest of Zbkb (brev8, zip, unzip)
+  parameter bit RV32Zk              = 1'b0
 ) (
   input  logic                 clk_i,
   input  logic                 rst_ni,
@@ -364,11 +366,20 @@ module cve2_decoder #(
               5'b0_1101: illegal_insn = (RV32B != RV32BNone) ? 1'b0 : 1'b1;           // binvi
               5'b0_0001: begin
                 if (instr[26] == 1'b0) begin                                          // shfl
-                  illegal_insn = (RV32B == RV32BOTEarlGrey || RV32B == RV32BFull) ? 1'b0 : 1'b1;
+                  if (RV32B == RV32BOTEarlGrey || RV32B == RV32BFull) begin
+                    illegal_insn = 1'b0;
+                  end else if (RV32Zk && RV32B != RV32BNone) begin
+                    illegal_insn = (instr[25:20] == 6'b00_1111) ? 1'b0 : 1'b1;        // zip
+                  end else begin
+                    illegal_insn = 1'b1;
+                  end
                 end else begin
                   illegal_insn = 1'b1;
                 end
               end
+              5'b0_0010: begin                                     // sha256sum0/sum1/sig0/sig1
+                illegal_insn = (RV32Zk && instr[26:22] == 5'b0_0000) ? 1'b0 : 1'b1;
+              end
               5'b0_1100: begin
                 unique case(instr[26:20])
                   7'b000_0000,                                                         // clz
@@ -409,7 +420,8 @@ module cve2_decoder #(
                   if (RV32B == RV32BOTEarlGrey || RV32B == RV32BFull) begin
                     illegal_insn = 1'b0;                                               // grevi
                   end else if (RV32B == RV32BBalanced) begin
-                    illegal_insn = (instr[24:20] == 5'b11000) ? 1'b0 : 1'b1;           // rev8
+                    illegal_insn = (instr[24:20] == 5'b11000 ||                         // rev8
+                                    (RV32Zk && instr[24:20] == 5'b00111)) ? 1'b0 : 1'b1; // brev8
                   end else begin
                     illegal_insn = 1'b1;
                   end
@@ -425,7 +437,13 @@ module cve2_decoder #(
                 end
                 5'b0_0001: begin
                   if (instr[26] == 1'b0) begin                                        // unshfl
-                    illegal_insn = (RV32B == RV32BOTEarlGrey || RV32B == RV32BFull) ? 1'b0 : 1'b1;
+                    if (RV32B == RV32BOTEarlGrey || RV32B == RV32BFull) begin
+                      illegal_insn = 1'b0;
+                    end else if (RV32Zk && RV32B != RV32BNone) begin
+                      illegal_insn = (instr[25:20] == 6'b00_1111) ? 1'b0 : 1'b1;      // unzip
+                    end else begin
+                      illegal_insn = 1'b1;
+                    end
                   end else begin
                     illegal_insn = 1'b1;
                   end
@@ -801,7 +819,15 @@ module cve2_decoder #(
           3'b111: alu_operator_o = ALU_AND;  // And with Immediate
 
           3'b001: begin
-            if (RV32B != RV32BNone) begin
+            if (RV32Zk && instr_alu[31:27] == 5'b0_0010) begin
+              unique case (instr_alu[21:20])
+                2'b00: alu_operator_o = ALU_SHA256_SUM0; // sha256sum0
+                2'b01: alu_operator_o = ALU_SHA256_SUM1; // sha256sum1
+                2'b10: alu_operator_o = ALU_SHA256_SIG0; // sha256sig0
+                2'b11: alu_operator_o = ALU_SHA256_SIG1; // sha256sig1
+                default: ;
+              endcase
+            end else if (RV32B != RV32BNone) begin
               unique case (instr_alu[31:27])
                 5'b0_0000: alu_operator_o = ALU_SLL;    // Shift Left Logical by Immediate
                 // Shift Left Ones by Immediate
@@ -894,7 +920,7 @@ module cve2_decoder #(
                   5'b0_0101: alu_operator_o = ALU_GORC;  // General Or-combine with Imm Control Val
                   // Unshuffle with Immediate Control Value
                   5'b0_0001: begin
-                    if (RV32B == RV32BOTEarlGrey || RV32B == RV32BFull) begin
+                    if (RV32B == RV32BOTEarlGrey || RV32B == RV32BFull || RV32Zk) begin
                       if (instr_alu[26] == 1'b0) alu_operator_o = ALU_UNSHFL;
                     end
                   end
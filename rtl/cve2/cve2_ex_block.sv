@@ -10,7 +10,8 @@
  */
 module cve2_ex_block #(
   parameter cve2_pkg::rv32m_e RV32M           = cve2_pkg::RV32MFast,
-  parameter cve2_pkg::rv32b_e RV32B           = cve2_pkg::RV32BNone
+  parameter cve2_pkg::rv32b_e RV32B           = cve2_pkg::RV32BNone,
+  parameter bit               RV32Zk          = 1'b0
 ) (
   input  logic                  clk_i,
   input  logic                  rst_ni,
@@ -93,7 +94,8 @@ module cve2_ex_block #(
   /////////
 
   cve2_alu #(
-    .RV32B(RV32B)
+    .RV32B(RV32B),
+    .RV32Zk(RV32Zk)
   ) alu_i (
     .operator_i         (alu_operator_i),
     .operand_a_i        (alu_operand_a_i),
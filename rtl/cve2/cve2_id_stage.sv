@@ -19,7 +19,8 @@
 module cve2_id_stage #(
   parameter bit               RV32E           = 0,
   parameter cve2_pkg::rv32m_e RV32M           = cve2_pkg::RV32MFast,
-  parameter cve2_pkg::rv32b_e RV32B           = cve2_pkg::RV32BNone
+  parameter cve2_pkg::rv32b_e RV32B           = cve2_pkg::RV32BNone,
+  parameter bit               RV32Zk          = 1'b0
 ) (
   input  logic                      clk_i,
   input  logic                      rst_ni,
@@ -336,7 +337,8 @@ module cve2_id_stage #(
   cve2_decoder #(
     .RV32E          (RV32E),
     .RV32M          (RV32M),
-    .RV32B          (RV32B)
+    .RV32B          (RV32B),
+    .RV32Zk         (RV32Zk)
   ) decoder_i (
     .clk_i (clk_i),
     .rst_ni(rst_ni),
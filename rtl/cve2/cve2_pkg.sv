@@ -174,7 +174,14 @@ package cve2_pkg;
     ALU_CRC32_H,
     ALU_CRC32C_H,
     ALU_CRC32_W,
-    ALU_CRC32C_W
+    ALU_CRC32C_W,
+
+    // SHA-256 sigma functions
+    // Zknh
+    ALU_SHA256_SUM0,
+    ALU_SHA256_SUM1,
+    ALU_SHA256_SIG0,
+    ALU_SHA256_SIG1
   } alu_op_e;
 
   typedef enum logic [1:0] {
@@ -953,6 +953,11 @@ module cve2_tracer (
         INSN_BSET:      decode_r_insn("bset");
         INSN_BINV:      decode_r_insn("binv");
         INSN_BEXT:      decode_r_insn("bext");
+        // ZKNH
+        INSN_SHA256SUM0: decode_r1_insn("sha256sum0");
+        INSN_SHA256SUM1: decode_r1_insn("sha256sum1");
+        INSN_SHA256SIG0: decode_r1_insn("sha256sig0");
+        INSN_SHA256SIG1: decode_r1_insn("sha256sig1");
         // RV32B - ZBE
         INSN_BDECOMPRESS: decode_r_insn("bdecompress");
         INSN_BCOMPRESS:   decode_r_insn("bcompress");
@@ -258,6 +258,12 @@ package cve2_tracer_pkg;
   // fsri.
   parameter logic [31:0] INSN_SROI   = { 5'b00100  , 1'b0, 11'h?, 3'b101, 5'h?, {OPCODE_OP_IMM} };
 
+  // ZKNH
+  parameter logic [31:0] INSN_SHA256SUM0 = { 12'h100, 5'h?, 3'b001, 5'h?, {OPCODE_OP_IMM} };
+  parameter logic [31:0] INSN_SHA256SUM1 = { 12'h101, 5'h?, 3'b001, 5'h?, {OPCODE_OP_IMM} };
+  parameter logic [31:0] INSN_SHA256SIG0 = { 12'h102, 5'h?, 3'b001, 5'h?, {OPCODE_OP_IMM} };
+  parameter logic [31:0] INSN_SHA256SIG1 = { 12'h103, 5'h?, 3'b001, 5'h?, {OPCODE_OP_IMM} };
+
   // ZBE
   parameter logic [31:0] INSN_BDECOMPRESS = {7'b0100100, 10'h?, 3'b110, 5'h?, {OPCODE_OP} };
   parameter logic [31:0] INSN_BCOMPRESS   = {7'b0000100, 10'h?, 3'b110, 5'h?, {OPCODE_OP} };
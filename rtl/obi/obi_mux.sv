@@ -29,7 +29,9 @@ module obi_mux #(
   /// The maximum number of outstanding transactions.
   parameter int unsigned       NumMaxTrans        = 32'd0,
   /// Use the extended ID field (aid & rid) to route the response
-  parameter bit                UseIdForRouting    = 1'b0
+  parameter bit                UseIdForRouting    = 1'b0,
+  /// The width of the priority of a subordinate port.
+  parameter int unsigned       PrioWidth          = 32'd1
 ) (
   input  logic clk_i,
   input  logic rst_ni,
@@ -37,6 +39,9 @@ module obi_mux #(
 
   input  sbr_port_obi_req_t [NumSbrPorts-1:0] sbr_ports_req_i,
   output sbr_port_obi_rsp_t [NumSbrPorts-1:0] sbr_ports_rsp_o,
+  /// Priority of each subordinate port: only the requests of the highest requesting
+  /// priority are arbitrated (round-robin among them). Tie to '0 for plain round-robin.
+  input  logic [NumSbrPorts-1:0][PrioWidth-1:0] sbr_ports_prio_i,
 
   output mgr_port_obi_req_t                   mgr_port_req_o,
   input  mgr_port_obi_rsp_t                   mgr_port_rsp_i
@@ -59,6 +64,35 @@ module obi_mux #(
   logic [RequiredExtraIdWidth-1:0] selected_id, response_id;
   logic mgr_port_req, fifo_full, fifo_pop;
 
+  // Priority: mask the requests below the highest requesting priority. The mask is held
+  // while the arbiter waits for a grant, as a presented request must not be withdrawn.
+  logic [NumSbrPorts-1:0] prio_mask_d, prio_mask_q, prio_mask, sbr_ports_req_prio;
+  logic [PrioWidth-1:0] prio_max;
+  logic prio_hold_q;
+
+  always_comb begin : proc_prio_mask
+    prio_max = '0;
+    for (int i = 0; i < NumSbrPorts; i++) begin
+      if (sbr_ports_req[i] && sbr_ports_prio_i[i] > prio_max) prio_max = sbr_ports_prio_i[i];
+    end
+    for (int i = 0; i < NumSbrPorts; i++) begin
+      prio_mask_d[i] = (sbr_ports_prio_i[i] == prio_max);
+    end
+  end
+
+  assign prio_mask          = prio_hold_q ? prio_mask_q : prio_mask_d;
+  assign sbr_ports_req_prio = sbr_ports_req & prio_mask;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_prio_hold
+    if (!rst_ni) begin
+      prio_mask_q <= '1;
+      prio_hold_q <= 1'b0;
+    end else begin
+      prio_mask_q <= prio_mask;
+      prio_hold_q <= mgr_port_req && !(mgr_port_rsp_i.gnt && ~fifo_full);
+    end
+  end
+
   rr_arb_tree #(
     .NumIn     ( NumSbrPorts       ),
     .DataType  ( sbr_port_a_chan_t ),
@@ -71,7 +105,7 @@ module obi_mux #(
     .flush_i ( 1'b0 ),
     .rr_i    ( '0 ),
 
-    .req_i   ( sbr_ports_req                    ),
+    .req_i   ( sbr_ports_req_prio               ),
     .gnt_o   ( sbr_ports_gnt                    ),
     .data_i  ( sbr_ports_a                      ),
 
@@ -173,13 +207,16 @@ module obi_mux_intf #(
   /// The maximum number of outstanding transactions.
   parameter int unsigned       NumMaxTrans        = 32'd0,
   /// Use the extended ID field (aid & rid) to route the response
-  parameter bit                UseIdForRouting    = 1'b0
+  parameter bit                UseIdForRouting    = 1'b0,
+  /// The width of the priority of a subordinate port.
+  parameter int unsigned       PrioWidth          = 32'd1
 ) (
   input logic         clk_i,
   input logic         rst_ni,
   input logic         testmode_i,
 
   OBI_BUS.Subordinate sbr_ports [NumSbrPorts],
+  input logic [NumSbrPorts-1:0][PrioWidth-1:0] sbr_ports_prio_i,
 
   OBI_BUS.Manager     mgr_port
 );
@@ -212,7 +249,8 @@ module obi_mux_intf #(
     .mgr_port_obi_rsp_t ( mgr_port_obi_rsp_t    ),
     .NumSbrPorts        ( NumSbrPorts           ),
     .NumMaxTrans        ( NumMaxTrans           ),
-    .UseIdForRouting    ( UseIdForRouting       )
+    .UseIdForRouting    ( UseIdForRouting       ),
+    .PrioWidth          ( PrioWidth             )
   ) i_obi_mux (
     .clk_i,
     .rst_ni,
@@ -220,6 +258,7 @@ module obi_mux_intf #(
 
     .sbr_ports_req_i ( sbr_ports_req ),
     .sbr_ports_rsp_o ( sbr_ports_rsp ),
+    .sbr_ports_prio_i,
 
     .mgr_port_req_o  ( mgr_port_req  ),
     .mgr_port_rsp_i  ( mgr_port_rsp  )
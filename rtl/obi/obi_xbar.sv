@@ -35,7 +35,9 @@ module obi_xbar #(
   /// Use the extended ID field (aid & rid) to route the response
   parameter bit                UseIdForRouting    = 1'b0,
   /// Connectivity matrix to disable certain paths.
-  parameter bit [NumSbrPorts-1:0][NumMgrPorts-1:0] Connectivity = '1
+  parameter bit [NumSbrPorts-1:0][NumMgrPorts-1:0] Connectivity = '1,
+  /// The width of the priority of a subordinate port, see `obi_mux`.
+  parameter int unsigned       PrioWidth          = 32'd1
 ) (
   input  logic clk_i,
   input  logic rst_ni,
@@ -49,7 +51,9 @@ module obi_xbar #(
 
   input  addr_map_rule_t [NumAddrRules-1:0]   addr_map_i,
   input  logic [NumSbrPorts-1:0]              en_default_idx_i,
-  input  logic [NumSbrPorts-1:0][cf_math_pkg::idx_width(NumMgrPorts)-1:0] default_idx_i
+  input  logic [NumSbrPorts-1:0][cf_math_pkg::idx_width(NumMgrPorts)-1:0] default_idx_i,
+  /// Priority of each subordinate port in the arbitration of every manager port.
+  input  logic [NumSbrPorts-1:0][PrioWidth-1:0] sbr_ports_prio_i
 );
 
   logic [NumSbrPorts-1:0][cf_math_pkg::idx_width(NumMgrPorts)-1:0] sbr_port_select;
@@ -141,13 +145,15 @@ module obi_xbar #(
       .mgr_port_obi_rsp_t ( mgr_port_obi_rsp_t ),
       .NumSbrPorts        ( NumSbrPorts        ),
       .NumMaxTrans        ( NumMaxTrans        ),
-      .UseIdForRouting    ( UseIdForRouting    )
+      .UseIdForRouting    ( UseIdForRouting    ),
+      .PrioWidth          ( PrioWidth          )
     ) i_mux (
       .clk_i,
       .rst_ni,
       .testmode_i,
       .sbr_ports_req_i ( mgr_reqs[i]        ),
       .sbr_ports_rsp_o ( mgr_rsps[i]        ),
+      .sbr_ports_prio_i,
       .mgr_port_req_o  ( mgr_ports_req_o[i] ),
       .mgr_port_rsp_i  ( mgr_ports_rsp_i[i] )
     );
@@ -176,7 +182,9 @@ module obi_xbar_intf #(
   /// Use the extended ID field (aid & rid) to route the response
   parameter bit                UseIdForRouting    = 1'b0,
   /// Connectivity matrix to disable certain paths.
-  parameter bit [NumSbrPorts-1:0][NumMgrPorts-1:0] Connectivity = '1
+  parameter bit [NumSbrPorts-1:0][NumMgrPorts-1:0] Connectivity = '1,
+  /// The width of the priority of a subordinate port, see `obi_mux`.
+  parameter int unsigned       PrioWidth          = 32'd1
 ) (
   input logic         clk_i,
   input logic         rst_ni,
@@ -188,7 +196,9 @@ module obi_xbar_intf #(
 
   input  addr_map_rule_t [NumAddrRules-1:0]   addr_map_i,
   input  logic [NumSbrPorts-1:0]              en_default_idx_i,
-  input  logic [NumSbrPorts-1:0][cf_math_pkg::idx_width(NumMgrPorts)-1:0] default_idx_i
+  input  logic [NumSbrPorts-1:0][cf_math_pkg::idx_width(NumMgrPorts)-1:0] default_idx_i,
+  /// Priority of each subordinate port in the arbitration of every manager port.
+  input  logic [NumSbrPorts-1:0][PrioWidth-1:0] sbr_ports_prio_i
 );
 
   `OBI_TYPEDEF_ALL(sbr_port_obi, SbrPortObiCfg)
@@ -225,7 +235,8 @@ module obi_xbar_intf #(
     .NumAddrRules       ( NumAddrRules          ),
     .addr_map_rule_t    ( addr_map_rule_t       ),
     .UseIdForRouting    ( UseIdForRouting       ),
-    .Connectivity       ( Connectivity          )
+    .Connectivity       ( Connectivity          ),
+    .PrioWidth          ( PrioWidth             )
   ) i_obi_xbar (
     .clk_i,
     .rst_ni,
@@ -236,7 +247,8 @@ module obi_xbar_intf #(
     .mgr_ports_rsp_i  ( mgr_ports_rsp    ),
     .addr_map_i       ( addr_map_i       ),
     .en_default_idx_i ( en_default_idx_i ),
-    .default_idx_i    ( default_idx_i    )
+    .default_idx_i    ( default_idx_i    ),
+    .sbr_ports_prio_i
   );
 
 endmodule
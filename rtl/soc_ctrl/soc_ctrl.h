@@ -33,6 +33,17 @@ extern "C" {
 #define SOC_CTRL_BOOTMODE_BOOTMODE_FIELD \
   ((bitfield_field32_t) { .mask = SOC_CTRL_BOOTMODE_BOOTMODE_MASK, .index = SOC_CTRL_BOOTMODE_BOOTMODE_OFFSET })
 
+// SRAM A_DLY value
+#define SOC_CTRL_SRAM_DLY_REG_OFFSET 0x10
+#define SOC_CTRL_SRAM_DLY_SRAM_DLY_BIT 0
+
+// Main xbar manager priorities
+#define SOC_CTRL_XBAR_PRIO_REG_OFFSET 0x14
+#define SOC_CTRL_XBAR_PRIO_XBAR_PRIO_MASK 0xff
+#define SOC_CTRL_XBAR_PRIO_XBAR_PRIO_OFFSET 0
+#define SOC_CTRL_XBAR_PRIO_XBAR_PRIO_FIELD \
+  ((bitfield_field32_t) { .mask = SOC_CTRL_XBAR_PRIO_XBAR_PRIO_MASK, .index = SOC_CTRL_XBAR_PRIO_XBAR_PRIO_OFFSET })
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
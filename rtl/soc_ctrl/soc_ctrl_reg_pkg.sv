@@ -33,6 +33,10 @@ package soc_ctrl_reg_pkg;
     logic        q;
   } soc_ctrl_reg2hw_sram_dly_reg_t;
 
+  typedef struct packed {
+    logic [7:0]  q;
+  } soc_ctrl_reg2hw_xbar_prio_reg_t;
+
   typedef struct packed {
     logic        d;
     logic        de;
@@ -45,11 +49,12 @@ package soc_ctrl_reg_pkg;
 
   // Register -> HW type
   typedef struct packed {
-    soc_ctrl_reg2hw_bootaddr_reg_t bootaddr; // [66:35]
-    soc_ctrl_reg2hw_fetchen_reg_t fetchen; // [34:34]
-    soc_ctrl_reg2hw_corestatus_reg_t corestatus; // [33:2]
-    soc_ctrl_reg2hw_bootmode_reg_t bootmode; // [1:1]
-    soc_ctrl_reg2hw_sram_dly_reg_t sram_dly; // [0:0]
+    soc_ctrl_reg2hw_bootaddr_reg_t bootaddr; // [74:43]
+    soc_ctrl_reg2hw_fetchen_reg_t fetchen; // [42:42]
+    soc_ctrl_reg2hw_corestatus_reg_t corestatus; // [41:10]
+    soc_ctrl_reg2hw_bootmode_reg_t bootmode; // [9:9]
+    soc_ctrl_reg2hw_sram_dly_reg_t sram_dly; // [8:8]
+    soc_ctrl_reg2hw_xbar_prio_reg_t xbar_prio; // [7:0]
   } soc_ctrl_reg2hw_t;
 
   // HW -> register type
@@ -64,6 +69,7 @@ package soc_ctrl_reg_pkg;
   parameter logic [BlockAw-1:0] SOC_CTRL_CORESTATUS_OFFSET = 5'h 8;
   parameter logic [BlockAw-1:0] SOC_CTRL_BOOTMODE_OFFSET = 5'h c;
   parameter logic [BlockAw-1:0] SOC_CTRL_SRAM_DLY_OFFSET = 5'h 10;
+  parameter logic [BlockAw-1:0] SOC_CTRL_XBAR_PRIO_OFFSET = 5'h 14;
 
   // Register index
   typedef enum int {
@@ -71,16 +77,18 @@ package soc_ctrl_reg_pkg;
     SOC_CTRL_FETCHEN,
     SOC_CTRL_CORESTATUS,
     SOC_CTRL_BOOTMODE,
-    SOC_CTRL_SRAM_DLY
+    SOC_CTRL_SRAM_DLY,
+    SOC_CTRL_XBAR_PRIO
   } soc_ctrl_id_e;
 
   // Register width information to check illegal writes
-  parameter logic [3:0] SOC_CTRL_PERMIT [5] = '{
+  parameter logic [3:0] SOC_CTRL_PERMIT [6] = '{
     4'b 1111, // index[0] SOC_CTRL_BOOTADDR
     4'b 0001, // index[1] SOC_CTRL_FETCHEN
     4'b 1111, // index[2] SOC_CTRL_CORESTATUS
     4'b 0001, // index[3] SOC_CTRL_BOOTMODE
-    4'b 0001  // index[4] SOC_CTRL_SRAM_DLY
+    4'b 0001, // index[4] SOC_CTRL_SRAM_DLY
+    4'b 0001  // index[5] SOC_CTRL_XBAR_PRIO
   };
 
 endpackage
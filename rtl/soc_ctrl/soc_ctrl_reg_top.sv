@@ -11,7 +11,8 @@ module soc_ctrl_reg_top #(
   parameter type reg_req_t = logic,
   parameter type reg_rsp_t = logic,
   parameter int AW = 5,
-  parameter int unsigned BootAddrDefault = 32'h0
+  parameter int unsigned BootAddrDefault = 32'h0,
+  parameter logic [7:0] XbarPrioDefault = 8'h0
 ) (
   input logic clk_i,
   input logic rst_ni,
@@ -84,6 +85,9 @@ module soc_ctrl_reg_top #(
   logic sram_dly_qs;
   logic sram_dly_wd;
   logic sram_dly_we;
+  logic [7:0] xbar_prio_qs;
+  logic [7:0] xbar_prio_wd;
+  logic xbar_prio_we;
 
   // Register instances
   // R[bootaddr]: V(False)
@@ -221,9 +225,36 @@ module soc_ctrl_reg_top #(
   );
 
 
+  // R[xbar_prio]: V(False)
+
+  prim_subreg #(
+    .DW      (8),
+    .SWACCESS("RW"),
+    .RESVAL  (XbarPrioDefault)
+  ) u_xbar_prio (
+    .clk_i   (clk_i    ),
+    .rst_ni  (rst_ni  ),
+
+    // from register interface
+    .we     (xbar_prio_we),
+    .wd     (xbar_prio_wd),
+
+    // from internal hardware
+    .de     (1'b0),
+    .d      ('0  ),
+
+    // to internal hardware
+    .qe     (),
+    .q      (reg2hw.xbar_prio.q ),
+
+    // to register interface (read)
+    .qs     (xbar_prio_qs)
+  );
 
 
-  logic [4:0] addr_hit;
+
+
+  logic [5:0] addr_hit;
   always_comb begin
     addr_hit = '0;
     addr_hit[0] = (reg_addr == SOC_CTRL_BOOTADDR_OFFSET);
@@ -231,6 +262,7 @@ module soc_ctrl_reg_top #(
     addr_hit[2] = (reg_addr == SOC_CTRL_CORESTATUS_OFFSET);
     addr_hit[3] = (reg_addr == SOC_CTRL_BOOTMODE_OFFSET);
     addr_hit[4] = (reg_addr == SOC_CTRL_SRAM_DLY_OFFSET);
+    addr_hit[5] = (reg_addr == SOC_CTRL_XBAR_PRIO_OFFSET);
   end
 
   assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0 ;
@@ -242,7 +274,8 @@ module soc_ctrl_reg_top #(
                (addr_hit[1] & (|(SOC_CTRL_PERMIT[1] & ~reg_be))) |
                (addr_hit[2] & (|(SOC_CTRL_PERMIT[2] & ~reg_be))) |
                (addr_hit[3] & (|(SOC_CTRL_PERMIT[3] & ~reg_be))) |
-               (addr_hit[4] & (|(SOC_CTRL_PERMIT[4] & ~reg_be)))));
+               (addr_hit[4] & (|(SOC_CTRL_PERMIT[4] & ~reg_be))) |
+               (addr_hit[5] & (|(SOC_CTRL_PERMIT[5] & ~reg_be)))));
   end
 
   assign bootaddr_we = addr_hit[0] & reg_we & !reg_error;
@@ -260,6 +293,9 @@ module soc_ctrl_reg_top #(
   assign sram_dly_we = addr_hit[4] & reg_we & !reg_error;
   assign sram_dly_wd = reg_wdata[0];
 
+  assign xbar_prio_we = addr_hit[5] & reg_we & !reg_error;
+  assign xbar_prio_wd = reg_wdata[7:0];
+
   // Read data return
   always_comb begin
     reg_rdata_next = '0;
@@ -284,6 +320,10 @@ module soc_ctrl_reg_top #(
         reg_rdata_next[0] = sram_dly_qs;
       end
 
+      addr_hit[5]: begin
+        reg_rdata_next[7:0] = xbar_prio_qs;
+      end
+
       default: begin
         reg_rdata_next = '1;
       end
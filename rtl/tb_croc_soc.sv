@@ -11,6 +11,7 @@ module tb_croc_soc #(
     parameter time         ClkPeriod     = 50ns,
     parameter time         ClkPeriodJtag = 50ns,
     parameter time         ClkPeriodRef  = 30518ns,
+    parameter time         ClkPeriodAcc  = 20ns,
     parameter time         TAppl         = 0.2*ClkPeriod,
     parameter time         TTest         = 0.8*ClkPeriod,
     parameter int unsigned RstCycles     = 1,
@@ -23,6 +24,7 @@ module tb_croc_soc #(
     logic clk;
     logic rst_n;
     logic ref_clk;
+    logic acc_clk;
 
     logic jtag_tck_i;
     logic jtag_trst_ni;
@@ -84,6 +86,14 @@ module tb_croc_soc #(
         .rst_no ( )
     );
 
+    clk_rst_gen #(
+        .ClkPeriod    ( ClkPeriodAcc ),
+        .RstClkCycles ( RstCycles )
+    ) i_clk_acc (
+        .clk_o  ( acc_clk ),
+        .rst_no ( )
+    );
+
     clk_rst_gen #(
         .ClkPeriod    ( ClkPeriodJtag ),
         .RstClkCycles ( RstCycles )
@@ -410,6 +420,7 @@ module tb_croc_soc #(
         .clk_i         ( clk        ),
         .rst_ni        ( rst_n      ),
         .ref_clk_i     ( ref_clk    ),
+        .acc_clk_i     ( acc_clk    ),
         .testmode_i    ( 1'b0       ),
         .fetch_en_i    ( fetch_en_i ),
         .status_o      ( status_o   ),
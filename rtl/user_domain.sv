@@ -10,6 +10,7 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
 ) (
   input  logic      clk_i,
   input  logic      ref_clk_i,
+  input  logic      acc_clk_i, // SHA-256 accelerator clock, used with ShaAsyncClk
   input  logic      rst_ni,
   input  logic      testmode_i,
   
@@ -23,15 +24,55 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
   output logic [NumExternalIrqs-1:0] interrupts_o // interrupts to core
 );
 
-  assign interrupts_o = '0;  
+  // SHA-256 accelerator instance i completes on external interrupt i (fast irq 3+i, mcause 19+i)
+  logic [NumShaInstances-1:0] acc_irq;
+
+  always_comb begin
+    interrupts_o                      = '0;
+    interrupts_o[NumShaInstances-1:0] = acc_irq;
+  end
+
+  if (NumShaInstances < 1 || NumShaInstances > NumExternalIrqs) begin : gen_num_sha_err
+    $fatal(1, "user_domain: NumShaInstances must be 1 to NumExternalIrqs");
+  end
 
 
   //////////////////////
   // User Manager MUX //
   /////////////////////
 
-  // No manager so we don't need a obi_mux module and just terminate the request properly
-  assign user_mgr_obi_req_o = '0;
+  // manager ports of the accelerator instances
+  mgr_obi_req_t [NumShaInstances-1:0] user_acc_mgr_obi_req;
+  mgr_obi_rsp_t [NumShaInstances-1:0] user_acc_mgr_obi_rsp;
+
+  if (NumShaInstances == 1) begin : gen_single_mgr
+    assign user_mgr_obi_req_o      = user_acc_mgr_obi_req[0];
+    assign user_acc_mgr_obi_rsp[0] = user_mgr_obi_rsp_i;
+  end else begin : gen_mgr_mux
+    // round-robin between the instances; the responses return in order, so
+    // every instance still sees its own responses in request order
+    obi_mux #(
+      .SbrPortObiCfg      ( MgrObiCfg        ),
+      .MgrPortObiCfg      ( MgrObiCfg        ),
+      .sbr_port_obi_req_t ( mgr_obi_req_t    ),
+      .sbr_port_a_chan_t  ( mgr_obi_a_chan_t ),
+      .sbr_port_obi_rsp_t ( mgr_obi_rsp_t    ),
+      .sbr_port_r_chan_t  ( mgr_obi_r_chan_t ),
+      .NumSbrPorts        ( NumShaInstances  ),
+      .NumMaxTrans        ( 4                )
+    ) i_user_mgr_mux (
+      .clk_i,
+      .rst_ni,
+      .testmode_i,
+
+      .sbr_ports_req_i  ( user_acc_mgr_obi_req ),
+      .sbr_ports_rsp_o  ( user_acc_mgr_obi_rsp ),
+      .sbr_ports_prio_i ( '0                   ),
+
+      .mgr_port_req_o   ( user_mgr_obi_req_o   ),
+      .mgr_port_rsp_i   ( user_mgr_obi_rsp_i   )
+    );
+  end
 
 
   ////////////////////////////
@@ -50,10 +91,19 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
   sbr_obi_req_t user_error_obi_req;
   sbr_obi_rsp_t user_error_obi_rsp;
 
+  // SHA-256 Accelerator Subordinate Buses
+  sbr_obi_req_t [NumShaInstances-1:0] user_acc_obi_req;
+  sbr_obi_rsp_t [NumShaInstances-1:0] user_acc_obi_rsp;
+
   // Fanout into more readable signals
   assign user_error_obi_req              = all_user_sbr_obi_req[UserError];
   assign all_user_sbr_obi_rsp[UserError] = user_error_obi_rsp;
 
+  for (genvar i = 0; i < NumShaInstances; i++) begin : gen_acc_sbr
+    assign user_acc_obi_req[i]               = all_user_sbr_obi_req[UserAcc+i];
+    assign all_user_sbr_obi_rsp[UserAcc+i]   = user_acc_obi_rsp[i];
+  end
+
 
   //-----------------------------------------------------------------------------------------------
   // Demultiplex to User Subordinates according to address map
@@ -115,4 +165,97 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
     .obi_rsp_o  ( user_error_obi_rsp )
   );
 
+  // SHA-256 Accelerators
+  logic acc_clk, acc_rst_n;
+
+  // accelerator side of the OBI ports, behind the CDCs with ShaAsyncClk
+  sbr_obi_req_t [NumShaInstances-1:0] acc_sbr_obi_req;
+  sbr_obi_rsp_t [NumShaInstances-1:0] acc_sbr_obi_rsp;
+  mgr_obi_req_t [NumShaInstances-1:0] acc_mgr_obi_req;
+  mgr_obi_rsp_t [NumShaInstances-1:0] acc_mgr_obi_rsp;
+  logic         [NumShaInstances-1:0] acc_irq_async;
+
+  if (ShaAsyncClk) begin : gen_acc_clk
+    assign acc_clk = acc_clk_i;
+
+    rstgen i_acc_rstgen (
+      .clk_i       ( acc_clk_i  ),
+      .rst_ni,
+      .test_mode_i ( testmode_i ),
+      .rst_no      ( acc_rst_n  ),
+      .init_no     (            )
+    );
+  end else begin : gen_acc_sync_clk
+    assign acc_clk   = clk_i;
+    assign acc_rst_n = rst_ni;
+  end
+
+  for (genvar i = 0; i < NumShaInstances; i++) begin : gen_sha
+    if (ShaAsyncClk) begin : gen_cdc
+      ethz_obi_cdc #(
+        .obi_req_t    ( sbr_obi_req_t    ),
+        .obi_rsp_t    ( sbr_obi_rsp_t    ),
+        .obi_a_chan_t ( sbr_obi_a_chan_t ),
+        .obi_r_chan_t ( sbr_obi_r_chan_t ),
+        .LogDepth     ( ShaCdcLogDepth   )
+      ) i_sbr_cdc (
+        .src_clk_i  ( clk_i               ),
+        .src_rst_ni ( rst_ni              ),
+        .src_req_i  ( user_acc_obi_req[i] ),
+        .src_rsp_o  ( user_acc_obi_rsp[i] ),
+        .dst_clk_i  ( acc_clk             ),
+        .dst_rst_ni ( acc_rst_n           ),
+        .dst_req_o  ( acc_sbr_obi_req[i]  ),
+        .dst_rsp_i  ( acc_sbr_obi_rsp[i]  )
+      );
+
+      ethz_obi_cdc #(
+        .obi_req_t    ( mgr_obi_req_t    ),
+        .obi_rsp_t    ( mgr_obi_rsp_t    ),
+        .obi_a_chan_t ( mgr_obi_a_chan_t ),
+        .obi_r_chan_t ( mgr_obi_r_chan_t ),
+        .LogDepth     ( ShaCdcLogDepth   )
+      ) i_mgr_cdc (
+        .src_clk_i  ( acc_clk                 ),
+        .src_rst_ni ( acc_rst_n               ),
+        .src_req_i  ( acc_mgr_obi_req[i]      ),
+        .src_rsp_o  ( acc_mgr_obi_rsp[i]      ),
+        .dst_clk_i  ( clk_i                   ),
+        .dst_rst_ni ( rst_ni                  ),
+        .dst_req_o  ( user_acc_mgr_obi_req[i] ),
+        .dst_rsp_i  ( user_acc_mgr_obi_rsp[i] )
+      );
+
+      // the interrupt is the level of DONE
+      sync #(
+        .STAGES     ( 2    ),
+        .ResetValue ( 1'b0 )
+      ) i_irq_sync (
+        .clk_i,
+        .rst_ni,
+        .serial_i ( acc_irq_async[i] ),
+        .serial_o ( acc_irq[i]       )
+      );
+    end else begin : gen_no_cdc
+      assign acc_sbr_obi_req[i]      = user_acc_obi_req[i];
+      assign user_acc_obi_rsp[i]     = acc_sbr_obi_rsp[i];
+      assign user_acc_mgr_obi_req[i] = acc_mgr_obi_req[i];
+      assign acc_mgr_obi_rsp[i]      = user_acc_mgr_obi_rsp[i];
+      assign acc_irq[i]              = acc_irq_async[i];
+    end
+
+    ethz_sha2 #(
+      .RoundsPerCycle ( ShaRoundsPerCycle ),
+      .NumLanes       ( ShaNumLanes       )
+    ) i_ethz_sha2 (
+      .clk_i              ( acc_clk            ),
+      .rst_ni             ( acc_rst_n          ),
+      .user_sbr_obi_req_i ( acc_sbr_obi_req[i] ),
+      .user_sbr_obi_rsp_o ( acc_sbr_obi_rsp[i] ),
+      .user_mgr_obi_req_o ( acc_mgr_obi_req[i] ),
+      .user_mgr_obi_rsp_i ( acc_mgr_obi_rsp[i] ),
+      .irq                ( acc_irq_async[i]   )
+    );
+  end
+
 endmodule
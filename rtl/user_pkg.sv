@@ -21,21 +21,60 @@ package user_pkg;
   // User Subordinate Address maps ////
   /////////////////////////////////////
 
-  localparam int unsigned NumUserDomainSubordinates = 0;
+  // SHA-256 accelerator instances (1 to NumExternalIrqs): instance i has the 4 KB
+  // register window at UserAccAddrOffset + i * UserAccAddrRange and external
+  // interrupt i; their manager ports share the user manager port
+`ifndef SHA_NUM_INSTANCES
+`define SHA_NUM_INSTANCES 1
+`endif
+  localparam int unsigned NumShaInstances = `SHA_NUM_INSTANCES;
 
-  localparam bit [31:0] UserRomAddrOffset   = croc_pkg::UserBaseAddr; // 32'h2000_0000;
-  localparam bit [31:0] UserRomAddrRange    = 32'h0000_1000;          // every subordinate has at least 4KB
+  localparam int unsigned NumUserDomainSubordinates = NumShaInstances;
+
+  localparam bit [31:0] UserAccAddrOffset   = croc_pkg::UserBaseAddr; // 32'h2000_0000;
+  localparam bit [31:0] UserAccAddrRange    = 32'h0000_1000;          // every subordinate has at least 4KB
 
   localparam int unsigned NumDemuxSbrRules  = NumUserDomainSubordinates; // number of address rules in the decoder
   localparam int unsigned NumDemuxSbr       = NumDemuxSbrRules + 1; // additional OBI error, used for signal arrays
 
-  // Enum for bus indices
+  // Enum for bus indices, instance i of the accelerator is UserAcc + i
   typedef enum int {
-    UserError = 0
+    UserError = 0,
+    UserAcc   = 1
   } user_demux_outputs_e;
 
+  // SHA-256 accelerator rounds per cycle (1, 2 or 4): 64, 32 or 16 cycles per
+  // block. Overridden by `make yosys-sha-sweep` through SHA_ROUNDS_PER_CYCLE.
+`ifndef SHA_ROUNDS_PER_CYCLE
+`define SHA_ROUNDS_PER_CYCLE 1
+`endif
+  localparam int unsigned ShaRoundsPerCycle = `SHA_ROUNDS_PER_CYCLE;
+
+  // SHA-256 accelerator lanes (1 to 4): messages hashed side by side in one job
+`ifndef SHA_NUM_LANES
+`define SHA_NUM_LANES 1
+`endif
+  localparam int unsigned ShaNumLanes = `SHA_NUM_LANES;
+
+  // SHA-256 accelerators on their own clock (acc_clk_i of croc_soc) instead of clk_i; both
+  // OBI ports then cross through a CDC with 2**ShaCdcLogDepth outstanding transactions
+`ifndef SHA_ASYNC_CLK
+`define SHA_ASYNC_CLK 0
+`endif
+  localparam bit          ShaAsyncClk    = `SHA_ASYNC_CLK;
+  localparam int unsigned ShaCdcLogDepth = 2;
+
+  // generate the address rules dependent on the number of accelerator instances
+  function automatic croc_pkg::addr_map_rule_t [NumDemuxSbrRules-1:0] gen_user_addr_rules();
+    croc_pkg::addr_map_rule_t [NumDemuxSbrRules-1:0] ret;
+    for (int i = 0; i < NumShaInstances; i++) begin
+      ret[i] = '{ idx: UserAcc+i,
+                  start_addr: UserAccAddrOffset + ( i    * UserAccAddrRange),
+                  end_addr:   UserAccAddrOffset + ((i+1) * UserAccAddrRange)};
+    end
+    return ret;
+  endfunction
+
   // Address rules given to address decoder
-  localparam croc_pkg::addr_map_rule_t [NumDemuxSbrRules-1:0] user_addr_map = '{
-    '{ idx: 32'd1,    start_addr: UserRomAddrOffset,    end_addr: UserRomAddrOffset   + UserRomAddrRange}
-  };
+  localparam croc_pkg::addr_map_rule_t [NumDemuxSbrRules-1:0] user_addr_map = gen_user_addr_rules();
 endpackage
@@ -0,0 +1,76 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nikola Tesic, ETH Zurich
+//
+// Core and accelerator on the SRAM banks at the same time: the accelerator
+// streams 2 KB of SRAM while the core runs the firmware hash, which fetches its
+// code and reads its data from SRAM as well. Run it on a chip built with and
+// without SRAM_INTERLEAVE and compare the lines. Each region is run with all xbar
+// managers at the same priority and with the core above the user domain
+// (soc_ctrl XBAR_PRIO).
+//
+// Line format:
+//   banks,<region>,<xbar prio>,<core cycles alone>,<core cycles with acc>,<acc busy>,<acc gnt wait>
+//
+// region 0 is the lower 2 KB (code), region 1 the upper 2 KB (data and stack);
+// with contiguous banks they are bank 0 and bank 1.
+
+#include "uart.h"
+#include "print.h"
+#include "util.h"
+#include "sha256.h"
+#include "acc.h"
+#include "soc_ctrl.h"
+
+#include <stdint.h>
+
+#define BANKS_SRAM   ((const uint8_t *)0x10000000)
+#define BANKS_REGION 2048
+
+// core instruction and data ports above the user domain
+#define BANKS_PRIO_CORE ((1 << SOC_CTRL_XBAR_PRIO_CORE_INSTR) | (1 << SOC_CTRL_XBAR_PRIO_CORE_DATA))
+
+// core workload: fetches code and reads its message from the code region
+static uint32_t banks_core_work(void) {
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    uint64_t start = get_mcycle();
+    sha256(BANKS_SRAM, 128, digest);
+    return (uint32_t)(get_mcycle() - start);
+}
+
+int main() {
+    uart_init();
+    acc_init();
+
+    uint32_t out[8];
+    acc_perf_t perf;
+
+    printf("banks,region,prio,core,core_acc,acc_busy,acc_gnt_wait\n");
+    uart_write_flush();
+
+    uint32_t alone = banks_core_work();
+
+    for (int r = 0; r < 2; r++) {
+        for (int p = 0; p < 2; p++) {
+            uint32_t prio = p ? BANKS_PRIO_CORE : 0;
+            *reg32(SOCCTRL_BASE_ADDR, SOC_CTRL_XBAR_PRIO_REG_OFFSET) = prio;
+
+            acc_perf_reset();
+            acc_start_bytes(BANKS_SRAM + r * BANKS_REGION, BANKS_REGION, out);
+            uint32_t shared = banks_core_work();
+            acc_wait();
+            acc_perf_read(&perf);
+
+            printf("banks,%u,%x,%u,%u,%u,%u\n", r, prio, alone, shared, perf.busy,
+                   perf.gnt_wait);
+            uart_write_flush();
+        }
+    }
+    *reg32(SOCCTRL_BASE_ADDR, SOC_CTRL_XBAR_PRIO_REG_OFFSET) = 0;
+
+    printf("banks,end\n");
+    uart_write_flush();
+    return 1;
+}
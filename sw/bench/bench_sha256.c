@@ -0,0 +1,194 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nikola Tesic, ETH Zurich
+//
+// Runs every SHA-256 backend over a sweep of message sizes and prints one CSV
+// line per (backend, size) over UART. bench/collect.py turns the simulation log
+// into a table with cycles per byte. The standalone kernels sw/SHA256.c,
+// SHA256_1.c and SHA256_2.c print the same line for their one 64-byte message;
+// they are separate programs, each with its own main, and do not fit into the
+// 4 KB SRAM next to this one.
+//
+// Line format:
+//   bench,<backend>,<bytes>,<reps>,<min cycles>,<median cycles>,<digest ok>
+
+#include "uart.h"
+#include "print.h"
+#include "util.h"
+#include "sha256.h"
+#include "acc.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BENCH_REPS 5
+
+// 4 KB of SRAM hold code, data and stack, so the largest message is 512 bytes.
+// The message is filled once in bench_fill() and never changes afterwards, so
+// the reference digest holds for every backend and repetition.
+#define BENCH_MAX_LEN 512
+static uint32_t bench_buf[BENCH_MAX_LEN / 4];
+#define BENCH_DATA ((const uint8_t *)bench_buf)
+
+static const uint32_t bench_sizes[] = {1, 55, 56, 64, 128, 256, 512};
+#define BENCH_NSIZES (sizeof(bench_sizes) / sizeof(bench_sizes[0]))
+
+// Every word holds the bytes x, y, y, x: its big-endian and little-endian
+// readings are equal, so the byte swap of the acc backend can run in place
+// without changing the message.
+static void bench_fill(void) {
+    for (uint32_t i = 0; i < BENCH_MAX_LEN / 4; i++) {
+        uint32_t x = (i * 29 + 7) & 0xff, y = (i * 71 + 3) & 0xff;
+        bench_buf[i] = (x << 24) | (y << 16) | (y << 8) | x;
+    }
+}
+
+// a backend returns 0 if it cannot hash a message of this length
+typedef int (*bench_fn_t)(const uint8_t *data, size_t len, uint8_t digest[SHA256_DIGEST_SIZE]);
+
+typedef struct {
+    const char *name;
+    bench_fn_t  fn;
+} bench_backend_t;
+
+static int bench_fw(const uint8_t *data, size_t len, uint8_t digest[SHA256_DIGEST_SIZE]) {
+    sha256(data, len, digest);
+    return 1;
+}
+
+static int bench_fw_fixed64(const uint8_t *data, size_t len, uint8_t digest[SHA256_DIGEST_SIZE]) {
+    if (len != SHA256_BLOCK_SIZE) return 0;
+    sha256_fixed64(data, digest);
+    return 1;
+}
+
+// The accelerator reads the message as big-endian words and writes the digest
+// as 8 words; the byte order conversion is part of the cost. It runs in place
+// on bench_buf, which the conversion leaves as it is (see bench_fill).
+static int bench_acc(const uint8_t *data, size_t len, uint8_t digest[SHA256_DIGEST_SIZE]) {
+    uint32_t *msg = (uint32_t *)bench_buf, out[8];
+    (void)data;
+
+    for (size_t i = 0; i < (len + 3) / 4; i++) {
+        const uint8_t *p = (const uint8_t *)&msg[i];
+        msg[i] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    }
+    acc_start(msg, len, out);
+    acc_wait();
+    for (int i = 0; i < 8; i++) {
+        digest[4 * i]     = (uint8_t)(out[i] >> 24);
+        digest[4 * i + 1] = (uint8_t)(out[i] >> 16);
+        digest[4 * i + 2] = (uint8_t)(out[i] >> 8);
+        digest[4 * i + 3] = (uint8_t)out[i];
+    }
+    return 1;
+}
+
+// The message is hashed in place, the accelerator does the byte order and
+// alignment; the digest comes back in byte order
+static int bench_acc_bytes(const uint8_t *data, size_t len, uint8_t digest[SHA256_DIGEST_SIZE]) {
+    uint32_t out[8];
+    acc_start_bytes(data, len, out);
+    acc_wait();
+    const uint8_t *p = (const uint8_t *)out;
+    for (int i = 0; i < SHA256_DIGEST_SIZE; i++) digest[i] = p[i];
+    return 1;
+}
+
+// One-block messages through the register window: no pointers, no memory
+// accesses by the accelerator, the digest is read from H0..H7
+static int bench_acc_pio(const uint8_t *data, size_t len, uint8_t digest[SHA256_DIGEST_SIZE]) {
+    uint32_t msg[16], out[8];
+    if (len > SHA256_BLOCK_SIZE) return 0;
+
+    for (size_t i = 0; i < (len + 3) / 4; i++) {
+        msg[i] = ((uint32_t)data[4 * i] << 24) | ((uint32_t)data[4 * i + 1] << 16) |
+                 ((uint32_t)data[4 * i + 2] << 8) | data[4 * i + 3];
+    }
+    acc_pio_start(msg, len, 0);
+    acc_wait();
+    acc_save_state(out);
+    for (int i = 0; i < 8; i++) {
+        digest[4 * i]     = (uint8_t)(out[i] >> 24);
+        digest[4 * i + 1] = (uint8_t)(out[i] >> 16);
+        digest[4 * i + 2] = (uint8_t)(out[i] >> 8);
+        digest[4 * i + 3] = (uint8_t)out[i];
+    }
+    return 1;
+}
+
+static const bench_backend_t bench_backends[] = {
+    {"fw",         bench_fw},
+    {"fw_fixed64", bench_fw_fixed64},
+    {"acc",        bench_acc},
+    {"acc_bytes",  bench_acc_bytes},
+    {"acc_pio",    bench_acc_pio},
+};
+#define BENCH_NBACKENDS (sizeof(bench_backends) / sizeof(bench_backends[0]))
+
+// insertion sort, BENCH_REPS is tiny
+static uint32_t bench_median(uint32_t *v, int n) {
+    for (int i = 1; i < n; i++) {
+        uint32_t x = v[i];
+        int j = i - 1;
+        while (j >= 0 && v[j] > x) {
+            v[j + 1] = v[j];
+            j--;
+        }
+        v[j + 1] = x;
+    }
+    return v[n / 2];
+}
+
+static int bench_digest_eq(const uint8_t *a, const uint8_t *b) {
+    for (int i = 0; i < SHA256_DIGEST_SIZE; i++) {
+        if (a[i] != b[i]) return 0;
+    }
+    return 1;
+}
+
+int main() {
+    uart_init();
+    acc_init();
+    bench_fill();
+
+    uint32_t cycles[BENCH_REPS];
+    uint8_t  ref[SHA256_DIGEST_SIZE];
+    uint8_t  digest[SHA256_DIGEST_SIZE];
+
+    printf("bench,backend,bytes,reps,min,median,ok\n");
+    uart_write_flush();
+
+    for (unsigned s = 0; s < BENCH_NSIZES; s++) {
+        uint32_t len = bench_sizes[s];
+        // the streaming firmware hash is the reference for every other backend
+        sha256(BENCH_DATA, len, ref);
+
+        for (unsigned b = 0; b < BENCH_NBACKENDS; b++) {
+            int ok = 1;
+
+            for (int r = 0; r < BENCH_REPS; r++) {
+                uint64_t start = get_mcycle();
+                ok &= bench_backends[b].fn(BENCH_DATA, len, digest);
+                uint64_t end = get_mcycle();
+                cycles[r] = (uint32_t)(end - start);
+            }
+            // size not supported by this backend
+            if (!ok) continue;
+
+            ok = bench_digest_eq(digest, ref);
+            uint32_t min = cycles[0];
+            for (int r = 1; r < BENCH_REPS; r++) min = MIN(min, cycles[r]);
+
+            printf("bench,%s,%u,%u,%u,%u,%u\n", bench_backends[b].name, len, BENCH_REPS, min,
+                   bench_median(cycles, BENCH_REPS), ok);
+            uart_write_flush();
+        }
+    }
+
+    printf("bench,end\n");
+    uart_write_flush();
+    return 1;
+}
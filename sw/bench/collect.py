@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+# Copyright 2025 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Nikola Tesic, ETH Zurich
+#
+# Collects the bench,... lines that a sw/bench program prints over UART from a
+# simulation log (e.g. `make verilator` output) and writes them as CSV with
+# cycles per byte added.
+#
+# Usage: collect.py [sim.log] > results.csv   (reads stdin if no log is given)
+
+import csv
+import re
+import sys
+
+# testbench prints UART lines as "@<time> | [UART] <text>"
+UART_RE = re.compile(r'\[UART\] (bench,.*)$')
+
+FIELDS = ['backend', 'bytes', 'reps', 'min_cycles', 'median_cycles',
+          'min_cpb', 'median_cpb', 'ok']
+
+
+def parse(lines):
+    rows = []
+    done = False
+    for line in lines:
+        m = UART_RE.search(line.rstrip())
+        if not m:
+            continue
+        cols = m.group(1).split(',')
+        if cols[1] == 'end':
+            done = True
+        elif cols[1] != 'backend' and len(cols) == 7:
+            nbytes, reps, cmin, cmed, ok = (int(c) for c in cols[2:])
+            rows.append({
+                'backend': cols[1],
+                'bytes': nbytes,
+                'reps': reps,
+                'min_cycles': cmin,
+                'median_cycles': cmed,
+                'min_cpb': f'{cmin / nbytes:.2f}',
+                'median_cpb': f'{cmed / nbytes:.2f}',
+                'ok': ok,
+            })
+    return rows, done
+
+
+def main():
+    with (open(sys.argv[1]) if len(sys.argv) > 1 else sys.stdin) as f:
+        rows, done = parse(f)
+
+    out = csv.DictWriter(sys.stdout, fieldnames=FIELDS)
+    out.writeheader()
+    out.writerows(rows)
+
+    if not done:
+        sys.exit('error: log ends before bench,end (simulation cut short?)')
+    if any(not r['ok'] for r in rows):
+        sys.exit('error: digest mismatch in ' +
+                 ', '.join(f"{r['backend']}/{r['bytes']}" for r in rows if not r['ok']))
+
+
+if __name__ == '__main__':
+    main()
@@ -12,6 +12,8 @@
 #define UART_BASE_ADDR    0x03002000
 #define GPIO_BASE_ADDR    0x03005000
 #define TIMER_BASE_ADDR   0x0300A000
+#define ACC_BASE_ADDR     0x20000000 // instance i at ACC_BASE_ADDR + i * ACC_INSTANCE_STRIDE
+#define ACC_INSTANCE_STRIDE 0x1000
 
 // Frequencies
 #define TB_FREQUENCY 20000000
@@ -21,4 +23,9 @@
 // UART
 #define UART_BYTE_ALIGN 4
 #define UART_FREQ       TB_FREQUENCY
-#define UART_BAUD       TB_BAUDRATE
\ No newline at end of file
+#define UART_BAUD       TB_BAUDRATE
+
+// SHA-256 accelerator instances, as user_pkg::NumShaInstances (SHA_NUM_INSTANCES)
+#ifndef ACC_NUM_INSTANCES
+#define ACC_NUM_INSTANCES 1
+#endif
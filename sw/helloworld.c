@@ -34,7 +34,7 @@ uint32_t isqrt(uint32_t n) {
 int main() {
     uart_init(); // setup the uart peripheral
 
-    // simple printf support (only prints text and hex numbers)
+    // simple printf support (%s %c %d %u %x, no floats)
     printf("Hello World!\n");
     // wait until uart has finished sending
     uart_write_flush();
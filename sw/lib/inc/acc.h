@@ -0,0 +1,180 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nikola Tesic, ETH Zurich
+
+#pragma once
+
+#include <stdint.h>
+#include "config.h"
+
+// Register offsets
+#define ACC_IN_PTR_REG_OFFSET  0x00 // address of the message, big-endian words
+#define ACC_OUT_PTR_REG_OFFSET 0x04 // address of the 8-word digest
+#define ACC_START_REG_OFFSET   0x08
+#define ACC_DONE_REG_OFFSET    0x0C // set by the accelerator, cleared by writing 0
+#define ACC_LEN_REG_OFFSET     0x10 // message length in bytes, padding is done in hardware
+#define ACC_CTRL_REG_OFFSET    0x14
+#define ACC_PRE_LEN_REG_OFFSET 0x18 // bytes hashed before this job, counted in the padding
+#define ACC_ITER_REG_OFFSET    0x1C // times the digest is hashed again before it is written
+#define ACC_H_REG_OFFSET       0x20 // H0..H7, chaining value to resume from / of the last job
+#define ACC_IH_REG_OFFSET      0x40 // IH0..IH7, HMAC inner key midstate
+#define ACC_OH_REG_OFFSET      0x60 // OH0..OH7, HMAC outer key midstate
+#define ACC_NONCE_REG_OFFSET   0x80 // nonce search: first nonce, then the hit or the next one
+#define ACC_COUNT_REG_OFFSET   0x84 // number of attempts
+#define ACC_TARGET_REG_OFFSET  0x88 // hit when H0 of the digest is below it
+#define ACC_NONCE_IDX_REG_OFFSET 0x8C // word of the template block that holds the nonce
+#define ACC_LANES_REG_OFFSET   0x90 // messages hashed side by side in one job
+#define ACC_STRIDE_REG_OFFSET  0x94 // bytes from one message to the next
+#define ACC_LANES_MAX_REG_OFFSET 0x98 // read only: lanes of the hardware
+#define ACC_RING_BASE_REG_OFFSET 0x9C // address of the descriptor ring
+#define ACC_RING_SIZE_REG_OFFSET 0xA0 // descriptors in the ring
+#define ACC_RING_HEAD_REG_OFFSET 0xA4 // next descriptor the accelerator runs
+#define ACC_RING_TAIL_REG_OFFSET 0xA8 // one past the last descriptor submitted
+#define ACC_RING_COUNT_REG_OFFSET 0xAC // descriptors run since acc_ring_init()
+#define ACC_RING_THRESH_REG_OFFSET 0xB0 // jobs per interrupt, 0: only when the ring drains
+#define ACC_MSG_REG_OFFSET     0xC0 // MSG0..MSG15, PIO message window
+#define ACC_PERF_REG_OFFSET    0x100 // performance counters, see acc_perf_t
+
+// CTRL bits
+#define ACC_CTRL_LOAD_H (1 << 0) // start from H0..H7 instead of the SHA-256 IV
+#define ACC_CTRL_NO_PAD (1 << 1) // len is a multiple of 64 and is not padded (not the last piece)
+#define ACC_CTRL_HMAC   (1 << 2) // HMAC of the message with the loaded key
+#define ACC_CTRL_KEY    (1 << 3) // load an HMAC key into IH/OH, nothing is written to out
+#define ACC_CTRL_SEARCH (1 << 4) // nonce search, see acc_search_setup()
+#define ACC_CTRL_RING   (1 << 5) // run the descriptor ring, see acc_ring_start()
+#define ACC_CTRL_PIO    (1 << 6) // message from MSG0..MSG15, digest left in H0..H7
+#define ACC_CTRL_BYTES  (1 << 7) // byte string at any address, digest written as bytes
+#define ACC_DESC_IRQ    (1u << 31) // descriptor ctrl: interrupt when this job is done
+
+// DONE bits
+#define ACC_DONE_FOUND  (1 << 1) // the nonce search had a hit
+#define ACC_DONE_ERR    (1 << 2) // a bus error ended the job
+
+// Performance counters, in register order; they run while the accelerator works
+// and can be read and reset at any time
+typedef struct {
+    uint32_t busy;     // cycles with START set
+    uint32_t stall;    // cycles the rounds wait for message data
+    uint32_t gnt_wait; // cycles a memory request waits for its grant
+    uint32_t wb;       // cycles of digest write-back
+    uint32_t blocks;   // 64-byte blocks compressed
+    uint32_t jobs;     // jobs completed
+} acc_perf_t;
+
+// Completion interrupt: first external interrupt = fast irq 3; instance i
+// raises ACC_IRQ_ID + i
+#define ACC_IRQ_ID 19
+
+// A job of the descriptor ring; ctrl holds the CTRL bits of the job and
+// ACC_DESC_IRQ. ITER, PRE_LEN, LANES and the search registers are taken from
+// the registers for every job of the ring.
+typedef struct {
+    const void *in;
+    uint32_t len;
+    void *out;
+    uint32_t ctrl;
+} acc_desc_t;
+
+// enables the completion interrupts of all instances in mie and mstatus
+void acc_init(void);
+
+// all following calls go to instance i < ACC_NUM_INSTANCES (0 after reset);
+// acc_done() and acc_wait() refer to the last job started on it. Jobs on
+// different instances run at the same time and share the memory port.
+void acc_select(uint32_t i);
+
+// clears DONE, programs the pointers and length and starts a hash; does not wait.
+// Byte i of the message is byte (3 - i % 4) of word i / 4 at in, i.e. the
+// message is read as big-endian words; bytes past len in the last word are ignored.
+void acc_start(const void *in, uint32_t len, void *out);
+
+// hashes the len bytes at in, any address, in place; the 32-byte digest is written
+// in byte order to out (word aligned). Does not wait.
+void acc_start_bytes(const void *in, uint32_t len, void *out);
+
+// as acc_start() with CTRL and PRE_LEN; to hash a message in pieces, pass
+// ACC_CTRL_NO_PAD for all but the last piece, ACC_CTRL_LOAD_H for all but the
+// first and the number of bytes of the earlier pieces as prelen
+void acc_start_ctrl(const void *in, uint32_t len, void *out, uint32_t ctrl, uint32_t prelen);
+
+// loads an HMAC key of up to 64 bytes (big-endian words as for acc_start()) into
+// IH/OH; does not wait. A longer key is hashed first and its digest loaded instead.
+void acc_hmac_key(const void *key, uint32_t len);
+
+// starts HMAC-SHA256 of the message with the loaded key; the MAC is written to out
+void acc_hmac_start(const void *in, uint32_t len, void *out);
+
+// as acc_start_ctrl(), and the digest is hashed iter more times before only the
+// last one is written, e.g. iter = 1 for SHA-256(SHA-256(m)); with ACC_CTRL_HMAC
+// every iteration is an HMAC with the loaded key
+void acc_start_iter(const void *in, uint32_t len, void *out, uint32_t ctrl, uint32_t prelen,
+                    uint32_t iter);
+
+// writes a message of up to 64 bytes (big-endian words as for acc_start()) into the
+// PIO window and hashes it with ctrl | ACC_CTRL_PIO; memory is not accessed, the
+// digest is read with acc_save_state() once done. Does not wait.
+void acc_pio_start(const uint32_t *msg, uint32_t len, uint32_t ctrl);
+
+// lanes of the hardware, the largest n for acc_start_batch()
+uint32_t acc_lanes(void);
+
+// hashes n <= acc_lanes() messages of len bytes each, message i at in + i * stride,
+// in one job: the rounds of all messages run side by side, their blocks are fetched in
+// turn. Digest i is
+// written to out + 32 * i. ctrl as for acc_start_ctrl() except KEY and SEARCH; with
+// LOAD_H all messages start from H0..H7, and H0..H7 holds the digest of message 0.
+void acc_start_batch(const void *in, uint32_t stride, uint32_t n, uint32_t len, void *out,
+                     uint32_t ctrl);
+
+// sets up an empty ring of size descriptors at ring; with thresh > 0 the interrupt
+// is raised after every thresh jobs, else only when the ring drains
+void acc_ring_init(acc_desc_t *ring, uint32_t size, uint32_t thresh);
+
+// runs the descriptors up to tail (exclusive) with one start; the accelerator must
+// be idle. Does not wait.
+void acc_ring_start(uint32_t tail);
+
+// submits the descriptors up to tail to a ring, also while it runs. A ring that
+// has already drained is started again.
+void acc_ring_append(uint32_t tail);
+
+// next descriptor the accelerator runs, readable while it runs
+uint32_t acc_ring_head(void);
+
+// sleeps until the accelerator has run the descriptors up to tail
+void acc_ring_wait(uint32_t tail);
+
+// sets up a nonce search, started with ACC_CTRL_SEARCH (and ACC_CTRL_LOAD_H and prelen
+// to resume after a midstate in H0..H7, never ACC_CTRL_HMAC). The template of len bytes is one block
+// (len <= 55). Attempt i hashes it with word nonce_idx (< 16) replaced by nonce + i,
+// for up to count attempts, and stops at the first digest whose H0 is below target;
+// that digest is written to out. Returns -1 without touching the registers if len
+// or nonce_idx is out of range.
+int acc_search_setup(uint32_t len, uint32_t nonce_idx, uint32_t nonce, uint32_t count,
+                     uint32_t target);
+
+// after a search: non-zero on a hit, *nonce is the hit or the next nonce to try
+int acc_search_result(uint32_t *nonce);
+
+// writes / reads the 8-word chaining value H0..H7 (only while the accelerator is idle)
+void acc_load_state(const uint32_t *h);
+void acc_save_state(uint32_t *h);
+
+// reads / clears the performance counters
+void acc_perf_read(acc_perf_t *perf);
+void acc_perf_reset(void);
+
+// non-zero once the completion interrupt of the last acc_start() was taken
+int acc_done(void);
+
+// after a job: non-zero if a bus error ended it (or stopped the ring); the
+// digest was not written
+int acc_error(void);
+
+// sleeps in wfi until the running hash completes
+void acc_wait(void);
+
+// acknowledges the completion interrupt of instance i, called from irq_handler()
+void acc_irq_handler(uint32_t i);
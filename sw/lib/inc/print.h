@@ -10,5 +10,5 @@
 
 extern void putchar(char);
 
-// simple printf with support for %x formatter but no others
+// simple printf with support for %s %c %d %u %x %X %%, the '0' flag and a field width
 void printf(const char *fmt, ...);
@@ -0,0 +1,38 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nikola Tesic, ETH Zurich
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SHA256_BLOCK_SIZE  64
+#define SHA256_DIGEST_SIZE 32
+
+// Streaming hash state; the buffer only ever holds a partial block
+typedef struct {
+    uint32_t state[8];                // chaining value H0..H7
+    uint64_t len;                     // total number of bytes absorbed
+    uint8_t  buf[SHA256_BLOCK_SIZE];  // pending bytes of the current block
+} sha256_ctx;
+
+// SHA-256 initial hash value (FIPS 180-4, 5.3.3)
+extern const uint32_t sha256_iv[8];
+
+// compress nblocks consecutive 64-byte blocks into state (big-endian message words)
+void sha256_compress(uint32_t state[8], const uint8_t *blocks, size_t nblocks);
+
+void sha256_init(sha256_ctx *ctx);
+void sha256_update(sha256_ctx *ctx, const void *data, size_t len);
+// pads the message, writes the binary digest and leaves ctx unusable until re-init
+void sha256_final(sha256_ctx *ctx, uint8_t digest[SHA256_DIGEST_SIZE]);
+
+// one-shot helper: init, update and final on a single buffer
+void sha256(const void *data, size_t len, uint8_t digest[SHA256_DIGEST_SIZE]);
+
+// fast path for exactly one 64-byte message: the constant padding block runs
+// from a precomputed W+K table instead of expanding its schedule
+void sha256_fixed64(const uint8_t msg[SHA256_BLOCK_SIZE], uint8_t digest[SHA256_DIGEST_SIZE]);
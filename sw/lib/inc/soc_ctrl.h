@@ -9,3 +9,10 @@
 #define SOC_CTRL_BOOTADDR_REG_OFFSET   0x00
 #define SOC_CTRL_FETCHEN_REG_OFFSET    0x04
 #define SOC_CTRL_CORESTATUS_REG_OFFSET 0x08
+#define SOC_CTRL_XBAR_PRIO_REG_OFFSET  0x14
+
+// XBAR_PRIO: 2-bit priority per main xbar manager, the highest requesting one wins
+#define SOC_CTRL_XBAR_PRIO_USER        0
+#define SOC_CTRL_XBAR_PRIO_DBG         2
+#define SOC_CTRL_XBAR_PRIO_CORE_DATA   4
+#define SOC_CTRL_XBAR_PRIO_CORE_INSTR  6
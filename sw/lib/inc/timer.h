@@ -40,4 +40,10 @@
 #define CFG_HIGH_REG_PRESC_ENABLE_BIT 6
 #define CFG_HIGH_REG_CLOCK_SOURCE_BIT 7
 
+// Machine timer interrupt
+#define TIMER_IRQ_ID 7
+
 void sleep_ms(uint32_t ms);
+
+// stops the timer and marks the end of sleep_ms(), called from irq_handler()
+void timer_irq_handler();
@@ -29,20 +29,34 @@
 #define UART_DLAB_MSB_REG_OFFSET      (1*UART_BYTE_ALIGN)
 
 // Register fields
+#define UART_INTR_ENABLE_THR_EMPTY_BIT 1
 #define UART_LINE_STATUS_DATA_READY_BIT 0
 #define UART_LINE_STATUS_THR_EMPTY_BIT 5
 #define UART_LINE_STATUS_TMIT_EMPTY_BIT 6
 
+#define UART_FIFO_DEPTH 16
+
+// TX ring buffer, power of two
+#define UART_TX_BUF_SIZE 128
+
+// UART interrupt: fast irq 1
+#define UART_IRQ_ID 17
+
 void uart_init();
 
 int uart_read_ready();
 
+// queues the byte; only blocks if the TX ring buffer is full
 void uart_write(uint8_t byte);
 
 void uart_write_str(void *src, uint32_t len);
 
+// drains the TX ring buffer and waits until the last byte left the shifter
 void uart_write_flush();
 
+// refills the TX FIFO from the ring buffer, called on the UART interrupt
+void uart_irq_handler();
+
 uint8_t uart_read();
 
 void uart_read_str(void *dst, uint32_t len);
@@ -47,10 +47,16 @@ static inline void set_mie(int enable) {
 }
 
 // Get cycle count since reset
+// RV32 splits the counter into mcycle/mcycleh; re-read if the high half
+// changed in between so a carry out of the low half is never lost.
 static inline uint64_t get_mcycle() {
-    uint64_t mcycle;
-    asm volatile("csrr %0, mcycle" : "=r"(mcycle)::"memory");
-    return mcycle;
+    uint32_t hi, lo, hi2;
+    do {
+        asm volatile("csrr %0, mcycleh" : "=r"(hi)::"memory");
+        asm volatile("csrr %0, mcycle" : "=r"(lo)::"memory");
+        asm volatile("csrr %0, mcycleh" : "=r"(hi2)::"memory");
+    } while (hi != hi2);
+    return ((uint64_t)hi << 32) | lo;
 }
 
 // This may also be used to invoke code that does not return.
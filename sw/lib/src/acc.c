@@ -0,0 +1,196 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nikola Tesic, ETH Zurich
+
+#include "acc.h"
+#include "util.h"
+#include "config.h"
+
+// set by the interrupt handler; .bss is not cleared at boot, acc_start() resets it
+static volatile int acc_irq_seen[ACC_NUM_INSTANCES];
+static volatile uint32_t acc_last_done[ACC_NUM_INSTANCES]; // DONE before it was cleared
+
+// registers of the selected instance; initialized, so it is not in .bss
+static uint32_t acc_base = ACC_BASE_ADDR;
+
+static inline uint32_t acc_cur(void) {
+    return (acc_base - ACC_BASE_ADDR) / ACC_INSTANCE_STRIDE;
+}
+
+void acc_irq_handler(uint32_t i) {
+    // the interrupt is level-sensitive, acknowledge by clearing DONE
+    uint32_t base = ACC_BASE_ADDR + i * ACC_INSTANCE_STRIDE;
+    uint32_t done = *reg32(base, ACC_DONE_REG_OFFSET);
+    // on its own clock the interrupt falls a few cycles after DONE, and can be taken again
+    if (done == 0)
+        return;
+    acc_last_done[i] = done;
+    *reg32(base, ACC_DONE_REG_OFFSET) = 0;
+    acc_irq_seen[i] = 1;
+}
+
+void acc_init(void) {
+    uint32_t mask = ((1 << ACC_NUM_INSTANCES) - 1) << ACC_IRQ_ID;
+    asm volatile("csrs mie, %0" ::"r"(mask) : "memory");
+    set_mie(1);
+}
+
+void acc_select(uint32_t i) {
+    acc_base = ACC_BASE_ADDR + i * ACC_INSTANCE_STRIDE;
+}
+
+static void acc_kick(const void *in, uint32_t len, void *out, uint32_t ctrl,
+                     uint32_t prelen, uint32_t iter, uint32_t lanes) {
+    acc_irq_seen[acc_cur()] = 0;
+    *reg32(acc_base, ACC_DONE_REG_OFFSET)    = 0;
+    *reg32(acc_base, ACC_IN_PTR_REG_OFFSET)  = (uint32_t)in;
+    *reg32(acc_base, ACC_OUT_PTR_REG_OFFSET) = (uint32_t)out;
+    *reg32(acc_base, ACC_LEN_REG_OFFSET)     = len;
+    *reg32(acc_base, ACC_CTRL_REG_OFFSET)    = ctrl;
+    *reg32(acc_base, ACC_PRE_LEN_REG_OFFSET) = prelen;
+    *reg32(acc_base, ACC_ITER_REG_OFFSET)    = iter;
+    *reg32(acc_base, ACC_LANES_REG_OFFSET)   = lanes;
+    *reg32(acc_base, ACC_START_REG_OFFSET)   = 1;
+}
+
+void acc_start_ctrl(const void *in, uint32_t len, void *out, uint32_t ctrl, uint32_t prelen) {
+    acc_kick(in, len, out, ctrl, prelen, 0, 1);
+}
+
+void acc_start_iter(const void *in, uint32_t len, void *out, uint32_t ctrl, uint32_t prelen,
+                    uint32_t iter) {
+    acc_kick(in, len, out, ctrl, prelen, iter, 1);
+}
+
+void acc_pio_start(const uint32_t *msg, uint32_t len, uint32_t ctrl) {
+    for (uint32_t i = 0; i < (len + 3) / 4 && i < 16; i++) {
+        *reg32(acc_base, ACC_MSG_REG_OFFSET + 4 * i) = msg[i];
+    }
+    acc_kick(0, len, 0, ctrl | ACC_CTRL_PIO, 0, 0, 1);
+}
+
+uint32_t acc_lanes(void) {
+    return *reg32(acc_base, ACC_LANES_MAX_REG_OFFSET);
+}
+
+void acc_start_batch(const void *in, uint32_t stride, uint32_t n, uint32_t len, void *out,
+                     uint32_t ctrl) {
+    *reg32(acc_base, ACC_STRIDE_REG_OFFSET) = stride;
+    acc_kick(in, len, out, ctrl, 0, 0, n);
+}
+
+void acc_ring_init(acc_desc_t *ring, uint32_t size, uint32_t thresh) {
+    *reg32(acc_base, ACC_RING_BASE_REG_OFFSET)   = (uint32_t)ring;
+    *reg32(acc_base, ACC_RING_SIZE_REG_OFFSET)   = size;
+    *reg32(acc_base, ACC_RING_HEAD_REG_OFFSET)   = 0;
+    *reg32(acc_base, ACC_RING_TAIL_REG_OFFSET)   = 0;
+    *reg32(acc_base, ACC_RING_COUNT_REG_OFFSET)  = 0;
+    *reg32(acc_base, ACC_RING_THRESH_REG_OFFSET) = thresh;
+}
+
+void acc_ring_start(uint32_t tail) {
+    acc_irq_seen[acc_cur()] = 0;
+    *reg32(acc_base, ACC_DONE_REG_OFFSET)      = 0;
+    // CTRL first: a TAIL write to a drained ring would start it by itself
+    *reg32(acc_base, ACC_CTRL_REG_OFFSET)      = ACC_CTRL_RING;
+    *reg32(acc_base, ACC_RING_TAIL_REG_OFFSET) = tail;
+    *reg32(acc_base, ACC_START_REG_OFFSET)     = 1;
+}
+
+void acc_ring_append(uint32_t tail) {
+    *reg32(acc_base, ACC_RING_TAIL_REG_OFFSET) = tail;
+}
+
+uint32_t acc_ring_head(void) {
+    return *reg32(acc_base, ACC_RING_HEAD_REG_OFFSET);
+}
+
+void acc_ring_wait(uint32_t tail) {
+    // HEAD steps in the cycle the interrupt is raised, so a wakeup after the
+    // flag is cleared always sees the HEAD of that interrupt
+    while (acc_ring_head() != tail) {
+        acc_wait();
+        acc_irq_seen[acc_cur()] = 0;
+    }
+}
+
+int acc_search_setup(uint32_t len, uint32_t nonce_idx, uint32_t nonce, uint32_t count,
+                     uint32_t target) {
+    // the template and its padding must fit one block, the nonce one of its words
+    if (len > 55 || nonce_idx > 15) return -1;
+    *reg32(acc_base, ACC_NONCE_IDX_REG_OFFSET) = nonce_idx;
+    *reg32(acc_base, ACC_NONCE_REG_OFFSET)     = nonce;
+    *reg32(acc_base, ACC_COUNT_REG_OFFSET)     = count;
+    *reg32(acc_base, ACC_TARGET_REG_OFFSET)    = target;
+    return 0;
+}
+
+int acc_search_result(uint32_t *nonce) {
+    *nonce = *reg32(acc_base, ACC_NONCE_REG_OFFSET);
+    return (acc_last_done[acc_cur()] & ACC_DONE_FOUND) != 0;
+}
+
+void acc_start(const void *in, uint32_t len, void *out) {
+    acc_start_ctrl(in, len, out, 0, 0);
+}
+
+void acc_start_bytes(const void *in, uint32_t len, void *out) {
+    acc_start_ctrl(in, len, out, ACC_CTRL_BYTES, 0);
+}
+
+void acc_hmac_key(const void *key, uint32_t len) {
+    acc_start_ctrl(key, len, 0, ACC_CTRL_KEY, 0);
+}
+
+void acc_hmac_start(const void *in, uint32_t len, void *out) {
+    acc_start_ctrl(in, len, out, ACC_CTRL_HMAC, 0);
+}
+
+void acc_load_state(const uint32_t *h) {
+    for (int i = 0; i < 8; i++) {
+        *reg32(acc_base, ACC_H_REG_OFFSET + 4 * i) = h[i];
+    }
+}
+
+void acc_save_state(uint32_t *h) {
+    for (int i = 0; i < 8; i++) {
+        h[i] = *reg32(acc_base, ACC_H_REG_OFFSET + 4 * i);
+    }
+}
+
+void acc_perf_read(acc_perf_t *perf) {
+    uint32_t *p = (uint32_t *)perf;
+    for (int i = 0; i < (int)(sizeof(*perf) / 4); i++) {
+        p[i] = *reg32(acc_base, ACC_PERF_REG_OFFSET + 4 * i);
+    }
+}
+
+void acc_perf_reset(void) {
+    for (int i = 0; i < (int)(sizeof(acc_perf_t) / 4); i++) {
+        *reg32(acc_base, ACC_PERF_REG_OFFSET + 4 * i) = 0;
+    }
+}
+
+int acc_done(void) {
+    return acc_irq_seen[acc_cur()];
+}
+
+int acc_error(void) {
+    return (acc_last_done[acc_cur()] & ACC_DONE_ERR) != 0;
+}
+
+void acc_wait(void) {
+    // Test the flag with interrupts masked so the irq cannot slip in between
+    // the test and wfi; wfi still wakes on the pending irq, which is then taken
+    // as soon as mstatus.MIE is set again.
+    volatile int *seen = &acc_irq_seen[acc_cur()];
+    set_mie(0);
+    while (!*seen) {
+        wfi();
+        set_mie(1);
+        set_mie(0);
+    }
+    set_mie(1);
+}
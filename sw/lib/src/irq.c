@@ -0,0 +1,27 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nikola Tesic, ETH Zurich
+
+#include <stdint.h>
+#include "uart.h"
+#include "timer.h"
+#include "acc.h"
+
+// Called from the trap vector in crt0.S for every interrupt
+void irq_handler(uint32_t mcause) {
+    switch (mcause & 0x7FFFFFFF) {
+        case UART_IRQ_ID:
+            uart_irq_handler();
+            break;
+        case TIMER_IRQ_ID:
+            timer_irq_handler();
+            break;
+        default:
+            if ((mcause & 0x7FFFFFFF) - ACC_IRQ_ID < ACC_NUM_INSTANCES) {
+                acc_irq_handler((mcause & 0x7FFFFFFF) - ACC_IRQ_ID);
+            }
+            break;
+    }
+}
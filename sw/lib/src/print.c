@@ -8,7 +8,7 @@
 #include "util.h"
 #include "config.h"
 
-const char hex_symbols[16] = {'0', '1', '2', '3', '4', '5', '6', '7', 
+const char hex_symbols[16] = {'0', '1', '2', '3', '4', '5', '6', '7',
                               '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
 
 /// @brief format number as hexadecimal digits
@@ -27,6 +27,26 @@ uint8_t format_hex32(char *buffer, uint32_t num) {
     return idx;
 }
 
+/// @brief format number as decimal digits (division comes from libgcc)
+/// @return number of characters written to buffer
+uint8_t format_dec32(char *buffer, uint32_t num) {
+    uint8_t idx = 0;
+    do {
+        buffer[idx++] = '0' + (num % 10);
+        num /= 10;
+    } while (num > 0);
+    return idx;
+}
+
+// buffer holds the digits in reverse order; pad up to width with pad
+static void print_padded(const char *buffer, int idx, int width, char pad, int neg) {
+    if (neg && pad == '0') putchar('-');
+    for (int j = idx + neg; j < width; j++) putchar(pad);
+    if (neg && pad == ' ') putchar('-');
+    for (int j = idx - 1; j >= 0; j--) putchar(buffer[j]);
+}
+
+// supports %s %c %d %u %x %X %%, with an optional '0' flag and field width
 void printf(const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
@@ -35,13 +55,45 @@ void printf(const char *fmt, ...) {
 
     while (*fmt) {
         if (*fmt == '%') {
+            char pad = ' ';
+            int width = 0;
             fmt++;
-            if (*fmt == 'x') { // hex
+            if (*fmt == '0') {
+                pad = '0';
+                fmt++;
+            }
+            while (*fmt >= '0' && *fmt <= '9') {
+                width = width * 10 + (*fmt - '0');
+                fmt++;
+            }
+
+            if (*fmt == 'x' || *fmt == 'X') { // hex
                 idx = format_hex32(buffer, va_arg(args, unsigned int));
-                // print from buffer
-                for (int j = idx - 1; j >= 0; j--) {
-                    putchar(buffer[j]);
+                if (*fmt == 'x') {
+                    for (int j = 0; j < idx; j++) {
+                        if (buffer[j] >= 'A') buffer[j] += 'a' - 'A';
+                    }
                 }
+                print_padded(buffer, idx, width, pad, 0);
+            } else if (*fmt == 'u') {
+                idx = format_dec32(buffer, va_arg(args, unsigned int));
+                print_padded(buffer, idx, width, pad, 0);
+            } else if (*fmt == 'd') {
+                int num = va_arg(args, int);
+                idx = format_dec32(buffer, num < 0 ? -(unsigned int)num : (unsigned int)num);
+                print_padded(buffer, idx, width, pad, num < 0);
+            } else if (*fmt == 's') {
+                const char *str = va_arg(args, const char *);
+                int len = 0;
+                while (str[len]) len++;
+                for (int j = len; j < width; j++) putchar(' ');
+                while (*str) putchar(*str++);
+            } else if (*fmt == 'c') {
+                putchar((char)va_arg(args, int));
+            } else if (*fmt == '%') {
+                putchar('%');
+            } else if (*fmt == '\0') {
+                break;
             }
         } else {
             putchar(*fmt);
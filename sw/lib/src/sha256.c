@@ -0,0 +1,224 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nikola Tesic, ETH Zurich
+
+#include "sha256.h"
+
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+#define CH(x, y, z)  ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+#ifdef __riscv_zknh
+// core with scalar crypto (SCALAR_CRYPTO=1 in the Makefile): one instruction each
+#define ZKNH(op, x) ({ uint32_t r_; asm(op " %0, %1" : "=r"(r_) : "r"(x)); r_; })
+#define EP0(x)  ZKNH("sha256sum0", x)
+#define EP1(x)  ZKNH("sha256sum1", x)
+#define SIG0(x) ZKNH("sha256sig0", x)
+#define SIG1(x) ZKNH("sha256sig1", x)
+#else
+#define EP0(x)  (ROTR(x, 2) ^ ROTR(x, 13) ^ ROTR(x, 22))
+#define EP1(x)  (ROTR(x, 6) ^ ROTR(x, 11) ^ ROTR(x, 25))
+#define SIG0(x) (ROTR(x, 7) ^ ROTR(x, 18) ^ ((x) >> 3))
+#define SIG1(x) (ROTR(x, 17) ^ ROTR(x, 19) ^ ((x) >> 10))
+#endif
+
+const uint32_t sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline uint32_t load_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline void store_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+// byte loops instead of memcpy/memset, we link without a libc
+static void sha256_copy(uint8_t *dst, const uint8_t *src, size_t n) {
+    while (n--) *dst++ = *src++;
+}
+
+static void sha256_zero(uint8_t *dst, size_t n) {
+    while (n--) *dst++ = 0;
+}
+
+// One round with renamed working variables: instead of shifting a..h, the caller
+// rotates the argument list, so only d and h are written. wk is W[t] + K[t].
+#define RND(a, b, c, d, e, f, g, h, wk)                             \
+    do {                                                            \
+        uint32_t t1 = (h) + EP1(e) + CH(e, f, g) + (wk);            \
+        (d) += t1;                                                  \
+        (h)  = t1 + EP0(a) + MAJ(a, b, c);                          \
+    } while (0)
+
+// Eight rounds, a full rotation of the working variables; WK(j) gives W + K of
+// round j of the group.
+#define RND8(WK)                                                    \
+    do {                                                            \
+        RND(a, b, c, d, e, f, g, h, WK(0));                         \
+        RND(h, a, b, c, d, e, f, g, WK(1));                         \
+        RND(g, h, a, b, c, d, e, f, WK(2));                         \
+        RND(f, g, h, a, b, c, d, e, WK(3));                         \
+        RND(e, f, g, h, a, b, c, d, WK(4));                         \
+        RND(d, e, f, g, h, a, b, c, WK(5));                         \
+        RND(c, d, e, f, g, h, a, b, WK(6));                         \
+        RND(b, c, d, e, f, g, h, a, WK(7));                         \
+    } while (0)
+
+// W[t] + K[t] of the constant second block of a 64-byte message
+// (0x80000000, 0, ..., 0, 0x00000200), computed offline; see sha256_fixed64
+static const uint32_t sha256_pad64_wk[64] = {
+    0xc28a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf374,
+    0x649b69c1, 0xf0fe4786, 0x0fe1edc6, 0x240cf254, 0x4fe9346f, 0x6cc984be, 0x61b9411e, 0x16f988fa,
+    0xf2c65152, 0xa88e5a6d, 0xb019fc65, 0xb9d99ec7, 0x9a1231c3, 0xe70eeaa0, 0xfdb1232b, 0xc7353eb0,
+    0x3069bad5, 0xcb976d5f, 0x5a0f118f, 0xdc1eeefd, 0x0a35b689, 0xde0b7a04, 0x58f4ca9d, 0xe15d5b16,
+    0x007f3e86, 0x37088980, 0xa507ea32, 0x6fab9537, 0x17406110, 0x0d8cd6f1, 0xcdaa3b6d, 0xc0bbbe37,
+    0x83613bda, 0xdb48a363, 0x0b02e931, 0x6fd15ca7, 0x521afaca, 0x31338431, 0x6ed41a95, 0x6d437890,
+    0xc39c91f2, 0x9eccabbd, 0xb5c9a0e6, 0x532fb63c, 0xd2c741c6, 0x07237ea3, 0xa4954b68, 0x4c191d76
+};
+
+// All 64 rounds of one block with schedule expansion.
+// m is the mirrored schedule buffer of sha256_compress: the 16-word schedule is
+// stored twice (m[i] and m[i+16]) and p points at the current group of eight
+// words, so every W[t-k] for k <= 16 is p[j-k] at a constant offset and neither
+// the unrolled rounds nor the expansion need index wrapping.
+static void sha256_rounds(uint32_t state[8], uint32_t *m) {
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    const uint32_t *k = sha256_k;
+
+    for (int grp = 0; grp < 8; grp++) {
+        uint32_t *p = m + 16 + ((grp & 1) << 3);
+        if (grp >= 2) {
+            for (uint32_t *q = p; q < p + 8; q++) {
+                q[0] = q[-16] = q[-16] + SIG1(q[-2]) + q[-7] + SIG0(q[-15]);
+            }
+        }
+#define WK_SCHED(j) (p[j] + k[j])
+        RND8(WK_SCHED);
+#undef WK_SCHED
+        k += 8;
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+// All 64 rounds of a block whose W[t] + K[t] is known in advance: one add per
+// round less and no schedule at all.
+static void sha256_rounds_wk(uint32_t state[8], const uint32_t *wk) {
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (int grp = 0; grp < 8; grp++) {
+#define WK_PRE(j) (wk[j])
+        RND8(WK_PRE);
+#undef WK_PRE
+        wk += 8;
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+void sha256_compress(uint32_t state[8], const uint8_t *blocks, size_t nblocks) {
+    uint32_t m[32];
+
+    while (nblocks--) {
+        for (int i = 0; i < 16; i++) {
+            m[i] = m[i + 16] = load_be32(blocks + 4 * i);
+        }
+        sha256_rounds(state, m);
+        blocks += SHA256_BLOCK_SIZE;
+    }
+}
+
+void sha256_fixed64(const uint8_t msg[SHA256_BLOCK_SIZE], uint8_t digest[SHA256_DIGEST_SIZE]) {
+    uint32_t state[8];
+    for (int i = 0; i < 8; i++) state[i] = sha256_iv[i];
+
+    sha256_compress(state, msg, 1);
+    // padding block: no schedule expansion and no K add
+    sha256_rounds_wk(state, sha256_pad64_wk);
+
+    for (int i = 0; i < 8; i++) store_be32(digest + 4 * i, state[i]);
+}
+
+void sha256_init(sha256_ctx *ctx) {
+    for (int i = 0; i < 8; i++) ctx->state[i] = sha256_iv[i];
+    ctx->len = 0;
+}
+
+void sha256_update(sha256_ctx *ctx, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    size_t used = (size_t)ctx->len & (SHA256_BLOCK_SIZE - 1);
+    ctx->len += len;
+
+    // top up a partially filled block first
+    if (used) {
+        size_t fill = SHA256_BLOCK_SIZE - used;
+        if (len < fill) {
+            sha256_copy(ctx->buf + used, p, len);
+            return;
+        }
+        sha256_copy(ctx->buf + used, p, fill);
+        sha256_compress(ctx->state, ctx->buf, 1);
+        p   += fill;
+        len -= fill;
+    }
+
+    // whole blocks are compressed in place without going through the buffer
+    size_t nblocks = len / SHA256_BLOCK_SIZE;
+    if (nblocks) {
+        sha256_compress(ctx->state, p, nblocks);
+        p   += nblocks * SHA256_BLOCK_SIZE;
+        len &= SHA256_BLOCK_SIZE - 1;
+    }
+
+    sha256_copy(ctx->buf, p, len);
+}
+
+void sha256_final(sha256_ctx *ctx, uint8_t digest[SHA256_DIGEST_SIZE]) {
+    size_t used   = (size_t)ctx->len & (SHA256_BLOCK_SIZE - 1);
+    uint64_t bits = ctx->len << 3;
+
+    // 0x80 terminator, zero fill and 64-bit length; may spill into one extra block
+    ctx->buf[used++] = 0x80;
+    if (used > SHA256_BLOCK_SIZE - 8) {
+        sha256_zero(ctx->buf + used, SHA256_BLOCK_SIZE - used);
+        sha256_compress(ctx->state, ctx->buf, 1);
+        used = 0;
+    }
+    sha256_zero(ctx->buf + used, SHA256_BLOCK_SIZE - 8 - used);
+    store_be32(ctx->buf + SHA256_BLOCK_SIZE - 8, (uint32_t)(bits >> 32));
+    store_be32(ctx->buf + SHA256_BLOCK_SIZE - 4, (uint32_t)bits);
+    sha256_compress(ctx->state, ctx->buf, 1);
+
+    for (int i = 0; i < 8; i++) store_be32(digest + 4 * i, ctx->state[i]);
+}
+
+void sha256(const void *data, size_t len, uint8_t digest[SHA256_DIGEST_SIZE]) {
+    sha256_ctx ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, len);
+    sha256_final(&ctx, digest);
+}
@@ -8,6 +8,17 @@
 #include "util.h"
 #include "config.h"
 
+// set by the timer interrupt; other interrupts (e.g. UART TX) also end wfi
+static volatile int timer_irq_seen;
+
+// the compare interrupt stays pending while the timer runs and MTIE is set, so
+// the handler stops both before it returns
+void timer_irq_handler() {
+    *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) = 0;
+    set_mtie(0);
+    timer_irq_seen = 1;
+}
+
 void sleep_ms(uint32_t ms) {
     uint32_t config = \
         (1 << CFG_LOW_REG_CLOCK_SOURCE_BIT) | // from 32.768 kHz ref clock
@@ -22,17 +33,19 @@ void sleep_ms(uint32_t ms) {
 
     *reg32(TIMER_BASE_ADDR, TIMER_CMP_LOW_REG_OFFSET) = ms;
 
+    timer_irq_seen = 0;
     set_mtie(1);  // Machine Timer Interrupt Enable
-    set_mie(1);  // Global Interrupt Enable
 
     // start timer
     *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) = config;
 
-    asm volatile("wfi");
-
-    // turn off timer
-    *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) &= ~(1 << CFG_LOW_REG_ENABLE_BIT);
-
-    // disable timer interrupt
-    set_mtie(0);
+    // Test the flag with interrupts masked so the irq cannot slip in between
+    // the test and wfi (the handler turns the timer off, nothing would wake us)
+    set_mie(0);
+    while (!timer_irq_seen) {
+        asm volatile("wfi");
+        set_mie(1);
+        set_mie(0);
+    }
+    set_mie(1);  // Global Interrupt Enable
 }
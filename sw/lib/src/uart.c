@@ -11,6 +11,12 @@
 
 #define UART_DIVISOR(freq, baud) ((freq) / ((baud) << 4))  // Divisor calculation
 
+// TX ring buffer: uart_write() produces at head, uart_tx_pump() consumes at tail
+static uint8_t uart_tx_buf[UART_TX_BUF_SIZE];
+static volatile uint32_t uart_tx_head, uart_tx_tail;
+// THR empty interrupt enabled: the handler drains the ring, writers need not pump
+static volatile uint32_t uart_tx_armed;
+
 void uart_init() {
     const uint16_t divisor = UART_DIVISOR(UART_FREQ, UART_BAUD); // Calculate from provided config
     uint8_t dlo = (uint8_t)(divisor);
@@ -22,6 +28,14 @@ void uart_init() {
     *reg8(UART_BASE_ADDR, UART_LINE_CONTROL_REG_OFFSET) = 0x03;  // 8 bits, no parity, one stop bit
     *reg8(UART_BASE_ADDR, UART_FIFO_CONTROL_REG_OFFSET) = 0xC7;  // Enable & clear FIFO, 14B threshold
     *reg8(UART_BASE_ADDR, UART_MODEM_CONTROL_REG_OFFSET) = 0x20; // Autoflow mode
+
+    // .bss is not cleared at boot
+    uart_tx_head = 0;
+    uart_tx_tail = 0;
+    uart_tx_armed = 0;
+    // the FIFO is refilled on THR empty once global interrupts are on;
+    // without them it is refilled when the ring is full or on a flush
+    asm volatile("csrs mie, %0" ::"r"(1 << UART_IRQ_ID) : "memory");
 }
 
 int uart_read_ready() {
@@ -37,10 +51,44 @@ static inline int __uart_write_idle() {
            *reg8(UART_BASE_ADDR, UART_LINE_STATUS_REG_OFFSET) & (1 << UART_LINE_STATUS_TMIT_EMPTY_BIT);
 }
 
+// THR empty means the whole FIFO is empty: push a burst of up to 16 bytes.
+// The THR empty interrupt is only left enabled while bytes are pending, as it
+// stays asserted on an empty FIFO. Must run with interrupts masked.
+static void uart_tx_pump() {
+    if (__uart_write_ready()) {
+        for (int n = 0; n < UART_FIFO_DEPTH && uart_tx_tail != uart_tx_head; ++n) {
+            *reg8(UART_BASE_ADDR, UART_THR_REG_OFFSET) = uart_tx_buf[uart_tx_tail];
+            uart_tx_tail = (uart_tx_tail + 1) & (UART_TX_BUF_SIZE - 1);
+        }
+    }
+    uint32_t armed = uart_tx_tail != uart_tx_head;
+    if (armed != uart_tx_armed) {
+        *reg8(UART_BASE_ADDR, UART_INTR_ENABLE_REG_OFFSET) =
+            armed ? (1 << UART_INTR_ENABLE_THR_EMPTY_BIT) : 0;
+        uart_tx_armed = armed;
+    }
+}
+
+// uart_tx_pump() with mstatus.MIE cleared, so it does not race the handler
+static void uart_tx_pump_masked() {
+    uint32_t mstatus;
+    asm volatile("csrrci %0, mstatus, 8" : "=r"(mstatus)::"memory");
+    uart_tx_pump();
+    asm volatile("csrs mstatus, %0" ::"r"(mstatus & 8) : "memory");
+}
+
+void uart_irq_handler() {
+    uart_tx_pump();
+}
+
 void uart_write(uint8_t byte) {
-    while (!__uart_write_ready())
-        ;
-    *reg8(UART_BASE_ADDR, UART_THR_REG_OFFSET) = byte;
+    uint32_t next = (uart_tx_head + 1) & (UART_TX_BUF_SIZE - 1);
+    while (next == uart_tx_tail) uart_tx_pump_masked();
+    uart_tx_buf[uart_tx_head] = byte;
+    uart_tx_head = next;
+    // with the interrupt armed the handler picks the byte up; head is already
+    // stepped, so a handler that disarms before this check leaves it to us
+    if (!uart_tx_armed) uart_tx_pump_masked();
 }
 
 void uart_write_str(void *src, uint32_t len) {
@@ -48,6 +96,12 @@ void uart_write_str(void *src, uint32_t len) {
 }
 
 void uart_write_flush() {
+    // wait for an empty FIFO before each pump, so every pump is a full burst
+    while (uart_tx_tail != uart_tx_head) {
+        while (!__uart_write_ready())
+            ;
+        uart_tx_pump_masked();
+    }
     while (!__uart_write_idle())
         ;
 }
@@ -8,6 +8,7 @@
 #include "timer.h"
 #include "gpio.h"
 #include "util.h"
+#include "acc.h"
 
 #include <stdint.h>
 #include <stddef.h>
@@ -40,11 +41,22 @@ static const uint32_t expected_results[16] = {
     0x83547F20, 0x5A7013D3, 0xD57BE8F1, 0xD4325C3A
 };
 
-// Hardware peripheral addresses
-static volatile uint32_t* acc_in_ptr_addr  = (volatile uint32_t*)0x20000000;
-static volatile uint32_t* acc_out_ptr_addr = (volatile uint32_t*)0x20000004;
-static volatile uint32_t* acc_start_addr   = (volatile uint32_t*)0x20000008;
-static volatile uint32_t* acc_done_flag    = (volatile uint32_t*)0x2000000C;
+// SHA-256(SHA-256(first block of input_1))
+static const uint32_t double_expected[8] = {
+    0x4B4647B0, 0xB34AD493, 0xE2F54FF0, 0x26AF6F69,
+    0xBACFAA1D, 0x6F0884A0, 0xE2D6F016, 0xEAD5D665
+};
+
+// HMAC-SHA256 test case 2 of RFC 4231, as big-endian words
+static const uint32_t hmac_key[1] = {0x4A656665}; // "Jefe"
+static const uint32_t hmac_msg[7] = {             // "what do ya want for nothing?"
+    0x77686174, 0x20646F20, 0x79612077, 0x616E7420,
+    0x666F7220, 0x6E6F7468, 0x696E673F
+};
+static const uint32_t hmac_expected[8] = {
+    0x5BDCC146, 0xBF60754E, 0x6A042426, 0x089575C7,
+    0x5A003F08, 0x9D273983, 0x9DEC58B9, 0x64EC3843
+};
 
 // Implementation of memcmp
 int my_memcmp(const void *s1, const void *s2, size_t n) {
@@ -58,31 +70,28 @@ int my_memcmp(const void *s1, const void *s2, size_t n) {
 
 int main() {
     uart_init();
+    acc_init();
 
     for (int iter = 0; iter < 2; ++iter) {
 
         uint32_t start_cycle, end_cycle, duration_cycle;
-        uint32_t wait_counter = 0;
 
         printf("Inizia:\n");
         uart_write_flush();
 
-        *acc_in_ptr_addr  = (uint32_t)(uintptr_t)&input_1[iter * 16];
-        *acc_out_ptr_addr = (uint32_t)(uintptr_t)&values[iter * 8];
-        *acc_start_addr = 0x1;
-
         start_cycle = get_mcycle();
 
-        while (*acc_done_flag != 0x00000001) {
-            wait_counter++;
-        }
+        acc_start(&input_1[iter * 16], 64, &values[iter * 8]);
+        // the core sleeps until the completion interrupt
+        acc_wait();
+
         end_cycle = get_mcycle();
 
         printf("Finisce.\n");
         uart_write_flush();
 
         duration_cycle = end_cycle - start_cycle;
-        printf("Durata cicli: %x (wait_counter: %u)\n", duration_cycle, wait_counter);
+        printf("Durata cicli: %x\n", duration_cycle);
         uart_write_flush();
 
         if (my_memcmp(&values[iter * 8], &expected_results[iter * 8], 8 * sizeof(uint32_t)) == 0) {
@@ -93,11 +102,10 @@ int main() {
         uart_write_flush();
 
 
-        if (*acc_done_flag == 0x00000001) {
-            *acc_done_flag = 0;
-            printf("Core ha letto l'output e resettato acc_done_flag per l'iterazione %d.\n", iter + 1);
+        if (acc_done()) {
+            printf("Interrupt ricevuto, DONE resettato dal gestore per l'iterazione %d.\n", iter + 1);
         } else {
-            printf("Attenzione: acc_done_flag non era 1 come atteso dopo l'elaborazione!\n");
+            printf("Attenzione: nessun interrupt ricevuto dopo l'elaborazione!\n");
         }
         printf("---- Fine Iterazione %d ----\n\n", iter + 1);
         uart_write_flush();
@@ -106,5 +114,150 @@ int main() {
     printf("Completate tutte le iterazioni.\n");
     uart_write_flush();
 
+    // The 128-byte message hashed in one job and in two pieces; between them
+    // the chaining value is saved and loaded again as on a context switch
+    uint32_t whole[8], piece[8], mid[8];
+    acc_start(input_1, 128, whole);
+    acc_wait();
+    acc_start_ctrl(input_1, 64, piece, ACC_CTRL_NO_PAD, 0);
+    acc_wait();
+    acc_save_state(mid);
+    acc_load_state(mid);
+    acc_start_ctrl(&input_1[16], 64, piece, ACC_CTRL_LOAD_H, 64);
+    acc_wait();
+    if (my_memcmp(whole, piece, sizeof(whole)) == 0) {
+        printf("Ripresa da H0..H7: successo.\n");
+    } else {
+        printf("Ripresa da H0..H7: errore.\n");
+    }
+    uart_write_flush();
+
+    // HMAC: the key is loaded once, then each MAC is a single job
+    acc_hmac_key(hmac_key, 4);
+    acc_wait();
+    acc_hmac_start(hmac_msg, 28, piece);
+    acc_wait();
+    if (my_memcmp(piece, hmac_expected, sizeof(piece)) == 0) {
+        printf("HMAC: successo.\n");
+    } else {
+        printf("HMAC: errore.\n");
+    }
+    uart_write_flush();
+
+    // Double hash in one job, the digest is rehashed inside the accelerator
+    acc_start_iter(input_1, 64, piece, 0, 0, 1);
+    acc_wait();
+    if (my_memcmp(piece, double_expected, sizeof(piece)) == 0) {
+        printf("Doppio hash: successo.\n");
+    } else {
+        printf("Doppio hash: errore.\n");
+    }
+    uart_write_flush();
+
+    // Nonce search over word 1 of hmac_msg: the first digest with H0 below
+    // 0x04000000 is at nonce 75 (H0 = 0x00E429B9)
+    uint32_t nonce;
+    nonce = 0;
+    if (acc_search_setup(28, 1, 0, 256, 0x04000000) == 0) {
+        acc_start_ctrl(hmac_msg, 28, piece, ACC_CTRL_SEARCH, 0);
+        acc_wait();
+    }
+    if (acc_search_result(&nonce) && nonce == 75 && piece[0] == 0x00E429B9) {
+        printf("Ricerca nonce: successo.\n");
+    } else {
+        printf("Ricerca nonce: errore (%u).\n", nonce);
+    }
+    uart_write_flush();
+
+    // The two blocks of input_1 as two 64-byte messages in one batch job,
+    // with as many lanes as the hardware has
+    uint32_t batch[16];
+    uint32_t lanes = acc_lanes() < 2 ? acc_lanes() : 2;
+    acc_start_batch(input_1, 64, lanes, 64, batch, 0);
+    acc_wait();
+    if (my_memcmp(batch, expected_results, lanes * 8 * sizeof(uint32_t)) == 0) {
+        printf("Batch (%u corsie): successo.\n", lanes);
+    } else {
+        printf("Batch (%u corsie): errore.\n", lanes);
+    }
+    uart_write_flush();
+
+    // Descriptor ring: the two blocks of input_1 and the whole message as three
+    // jobs started with one kick, one interrupt when the ring drains
+    static acc_desc_t ring[4];
+    uint32_t ring_out[24];
+    for (int i = 0; i < 2; i++) {
+        ring[i].in = &input_1[i * 16];
+        ring[i].len = 64;
+        ring[i].out = &ring_out[i * 8];
+        ring[i].ctrl = 0;
+    }
+    ring[2].in = input_1;
+    ring[2].len = 128;
+    ring[2].out = &ring_out[16];
+    ring[2].ctrl = 0;
+    acc_ring_init(ring, 4, 0);
+    acc_ring_start(3);
+    acc_ring_wait(3);
+    if (my_memcmp(ring_out, expected_results, 16 * sizeof(uint32_t)) == 0
+        && my_memcmp(&ring_out[16], whole, sizeof(whole)) == 0) {
+        printf("Anello di descrittori: successo.\n");
+    } else {
+        printf("Anello di descrittori: errore.\n");
+    }
+    uart_write_flush();
+
+    // PIO: the first block of input_1 through the register window, the digest
+    // is read back from H0..H7
+    acc_pio_start(input_1, 64, 0);
+    acc_wait();
+    acc_save_state(piece);
+    if (my_memcmp(piece, expected_results, sizeof(piece)) == 0) {
+        printf("PIO: successo.\n");
+    } else {
+        printf("PIO: errore.\n");
+    }
+    uart_write_flush();
+
+    // "abc" one byte into a string, hashed in place as a byte string
+    static const char abc[] = "xabc";
+    static const uint8_t abc_expected[32] = {
+        0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+        0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+    acc_start_bytes(&abc[1], 3, piece);
+    acc_wait();
+    if (my_memcmp(piece, abc_expected, sizeof(piece)) == 0) {
+        printf("Byte non allineati: successo.\n");
+    } else {
+        printf("Byte non allineati: errore.\n");
+    }
+    uart_write_flush();
+
+    // Every instance hashes the 128-byte message at the same time
+    static uint32_t multi[ACC_NUM_INSTANCES][8];
+    for (uint32_t i = 0; i < ACC_NUM_INSTANCES; i++) {
+        acc_select(i);
+        acc_start(input_1, 128, multi[i]);
+    }
+    int multi_ok = 1;
+    for (uint32_t i = 0; i < ACC_NUM_INSTANCES; i++) {
+        acc_select(i);
+        acc_wait();
+        multi_ok &= my_memcmp(multi[i], whole, sizeof(whole)) == 0;
+    }
+    acc_select(0);
+    printf("Istanze (%u): %s.\n", ACC_NUM_INSTANCES, multi_ok ? "successo" : "errore");
+    uart_write_flush();
+
+    // Where the cycles of the 128-byte job go
+    acc_perf_t perf;
+    acc_perf_reset();
+    acc_start(input_1, 128, whole);
+    acc_wait();
+    acc_perf_read(&perf);
+    printf("Contatori: busy %u, attesa dati %u, attesa gnt %u, scrittura %u, blocchi %u, job %u\n",
+           perf.busy, perf.stall, perf.gnt_wait, perf.wb, perf.blocks, perf.jobs);
+    uart_write_flush();
+
     return 1;
 }
\ No newline at end of file
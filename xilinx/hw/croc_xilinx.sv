@@ -250,6 +250,7 @@ module croc_xilinx import croc_pkg::*; #(
     .clk_i           ( soc_clk        ),
     .rst_ni          ( rst_n          ),
     .ref_clk_i       ( rtc_clk_q      ),
+    .acc_clk_i       ( soc_clk        ),
     .testmode_i      ( soc_testmode_i ),
     .fetch_en_i      ( soc_fetch_en   ),
     .status_o        ( status_o       ),
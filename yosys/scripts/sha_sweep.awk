@@ -0,0 +1,23 @@
+# Copyright (c) 2025 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# One line of yosys/sha_sweep.csv from the reports of a yosys-sha-sweep run:
+#   gawk -v rev=<rev> -v rounds=<n> -f sha_sweep.awk <top>_area.rpt <top>_sha_depth.rpt
+# prints "<rev>,<n>,<ethz_sha2 area>,<longest path of ethz_sha2 in generic gates>"
+
+/Chip area for module .*ethz_sha2/ {
+   area = $NF
+}
+
+/Longest topological path in .*ethz_sha2/ {
+   d = $0
+   sub(/.*length=/, "", d)
+   sub(/[^0-9].*/, "", d)
+   if (d + 0 > depth + 0)
+      depth = d
+}
+
+END {
+   printf "%s,%s,%s,%s\n", rev, rounds, area, depth
+}
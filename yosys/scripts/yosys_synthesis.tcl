@@ -21,9 +21,17 @@ set abc_script [processAbcScript scripts/abc-opt.script]
 # read liberty files and prepare some variables
 source scripts/init_tech.tcl
 
+# extra defines on top of the flist (space separated NAME=VALUE)
+set sv_defines {}
+if {[envVarValid YOSYS_DEFINES]} {
+    foreach def $::env(YOSYS_DEFINES) {
+        lappend sv_defines -D $def
+    }
+}
+
 yosys plugin -i slang.so
 # default from yosys_common.tcl: top_design=croc_chip; sv_flist=../croc.flist
-yosys read_slang --top $top_design -F $sv_flist \
+yosys read_slang --top $top_design -F $sv_flist {*}$sv_defines \
         --compat-mode --keep-hierarchy \
         --allow-use-before-declare --ignore-unknown-modules
 
@@ -41,6 +49,7 @@ yosys setattr -set keep_hierarchy 1 "t:dmi_jtag$*"
 yosys setattr -set keep_hierarchy 1 "t:dm_top$*"
 yosys setattr -set keep_hierarchy 1 "t:gpio$*"
 yosys setattr -set keep_hierarchy 1 "t:timer_unit$*"
+yosys setattr -set keep_hierarchy 1 "t:ethz_sha2$*"
 yosys setattr -set keep_hierarchy 1 "t:reg_uart_wrap$*"
 yosys setattr -set keep_hierarchy 1 "t:soc_ctrl_reg_top$*"
 yosys setattr -set keep_hierarchy 1 "t:tc_clk*$*"
@@ -102,6 +111,8 @@ yosys clean -purge
 # -----------------------------------------------------------------------------
 yosys tee -q -o "${rep_dir}/${top_design}_generic.rpt" stat -tech cmos
 yosys tee -q -o "${rep_dir}/${top_design}_generic.json" stat -json -tech cmos
+# logic depth of the SHA-256 accelerator in generic gates (timing proxy)
+yosys tee -q -o "${rep_dir}/${top_design}_sha_depth.rpt" ltp -noff "ethz_sha2$*"
 
 # flatten all hierarchy except marked modules
 yosys flatten
@@ -39,16 +39,37 @@ $(NETLIST) $(NETLIST_DEBUG):  $(SV_FLIST)
 	TMP="$(YOSYS_TMP)" \
 	OUT="$(YOSYS_OUT)" \
 	REPORTS="$(YOSYS_REPORTS)" \
+	YOSYS_DEFINES="$(YOSYS_DEFINES)" \
 	$(YOSYS) -c $(YOSYS_DIR)/scripts/yosys_synthesis.tcl \
 		2>&1 | TZ=UTC gawk '{ print strftime("[%Y-%m-%d %H:%M %Z]"), $$0 }' \
 		     | tee "$(YOSYS_DIR)/$(TOP_DESIGN).log" \
 		     | gawk -f $(YOSYS_DIR)/scripts/filter_output.awk;
 		
 
+# SHA-256 accelerator settings to compare (user_pkg::ShaRoundsPerCycle)
+SHA_ROUNDS_SWEEP ?= 1 2 4
+# one line per setting and revision: rev,rounds_per_cycle,sha_area,sha_depth
+SHA_SWEEP_CSV    ?= $(YOSYS_DIR)/sha_sweep.csv
+SHA_SWEEP_REV    ?= $(shell git -C $(YOSYS_DIR) rev-parse --short HEAD)
+
+## Synthesize once per SHA-256 rounds-per-cycle setting (reports in yosys/reports/sha_r<N>,
+## ethz_sha2 area and logic depth appended to yosys/sha_sweep.csv)
+yosys-sha-sweep: $(SV_FLIST)
+	test -f $(SHA_SWEEP_CSV) || echo "rev,rounds_per_cycle,sha_area,sha_depth" > $(SHA_SWEEP_CSV)
+	for r in $(SHA_ROUNDS_SWEEP); do \
+		$(MAKE) yosys YOSYS_DEFINES="SHA_ROUNDS_PER_CYCLE=$$r" \
+			YOSYS_OUT=$(YOSYS_OUT)/sha_r$$r \
+			YOSYS_TMP=$(YOSYS_TMP)/sha_r$$r \
+			YOSYS_REPORTS=$(YOSYS_REPORTS)/sha_r$$r || exit 1; \
+		gawk -v rev=$(SHA_SWEEP_REV) -v rounds=$$r -f $(YOSYS_DIR)/scripts/sha_sweep.awk \
+			$(YOSYS_REPORTS)/sha_r$$r/$(TOP_DESIGN)_area.rpt \
+			$(YOSYS_REPORTS)/sha_r$$r/$(TOP_DESIGN)_sha_depth.rpt >> $(SHA_SWEEP_CSV); \
+	done
+
 ys_clean:
 	rm -rf $(YOSYS_OUT)
 	rm -rf $(YOSYS_TMP)
 	rm -rf $(YOSYS_REPORTS) 
 	rm -f $(YOSYS_DIR)/$(TOP_DESIGN).log
 
-.PHONY: ys_clean yosys
+.PHONY: ys_clean yosys yosys-sha-sweep